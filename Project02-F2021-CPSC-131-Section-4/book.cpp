@@ -1,6 +1,8 @@
 #include "book.hpp"
 
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -168,4 +170,21 @@ std::ostream& operator<<(std::ostream& stream, const Book& book) {
       << (book.price_)
       << std::endl;
   return stream;
+}
+
+//
+// Hashing
+//
+
+std::size_t std::hash<Book>::operator()(const Book& book) const noexcept {
+  // Fold each field's hash into the running value, as boost::hash_combine
+  // does.
+  std::size_t seed = 0;
+  for (std::size_t field : {std::hash<std::string>()(book.isbn()),
+                            std::hash<std::string>()(book.title()),
+                            std::hash<std::string>()(book.author()),
+                            std::hash<double>()(book.price())}) {
+    seed ^= field + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef _book_hpp_
 #define _book_hpp_
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -86,4 +88,11 @@ class Book {
   double price_ = 0.0;
 };
 
+// Hashes books by all four fields, so that books can key unordered
+// containers.
+template <>
+struct std::hash<Book> {
+  std::size_t operator()(const Book& book) const noexcept;
+};
+
 #endif
\ No newline at end of file
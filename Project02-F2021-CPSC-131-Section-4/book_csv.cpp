@@ -0,0 +1,279 @@
+#include "book_csv.hpp"
+
+#include <cctype>
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+namespace {
+
+// Returns the column a header names, or CsvColumn::IGNORE if none.
+CsvColumn column_named(const std::string& name) {
+  std::string lowered;
+  for (char c : name) {
+    lowered += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  if (lowered == "isbn") {
+    return CsvColumn::ISBN;
+  }
+  if (lowered == "title") {
+    return CsvColumn::TITLE;
+  }
+  if (lowered == "author") {
+    return CsvColumn::AUTHOR;
+  }
+  if (lowered == "price") {
+    return CsvColumn::PRICE;
+  }
+  return CsvColumn::IGNORE;
+}
+
+// Returns the header name of column.
+const char* name_of(CsvColumn column) {
+  switch (column) {
+    case CsvColumn::ISBN:
+      return "isbn";
+    case CsvColumn::TITLE:
+      return "title";
+    case CsvColumn::AUTHOR:
+      return "author";
+    case CsvColumn::PRICE:
+      return "price";
+    case CsvColumn::IGNORE:
+      break;
+  }
+  return "";
+}
+
+}  // namespace
+
+//
+// Reading
+//
+
+BookCsvReader::BookCsvReader(std::istream& stream, CsvFormat format)
+    : stream_(stream),
+      format_(std::move(format)),
+      header_pending_(format_.header) {}
+
+bool BookCsvReader::next(Book& book) {
+  if (header_pending_) {
+    header_pending_ = false;
+    if (!read_record()) {
+      return false;
+    }
+    format_.columns.assign(field_count_, CsvColumn::IGNORE);
+    for (std::size_t i = 0; i < field_count_; ++i) {
+      format_.columns[i] = column_named(fields_[i]);
+    }
+  }
+
+  // Skip blank lines. A record of one empty quoted field is not blank.
+  do {
+    if (!read_record()) {
+      return false;
+    }
+  } while (blank_line_);
+
+  book = Book();
+  for (std::size_t i = 0; i < format_.columns.size() && i < field_count_;
+       ++i) {
+    const std::string& field = fields_[i];
+    switch (format_.columns[i]) {
+      case CsvColumn::ISBN:
+        book.isbn(field);
+        break;
+      case CsvColumn::TITLE:
+        book.title(field);
+        break;
+      case CsvColumn::AUTHOR:
+        book.author(field);
+        break;
+      case CsvColumn::PRICE: {
+        double price = 0.0;
+        const char* end = field.data() + field.size();
+        auto [last, error] = std::from_chars(field.data(), end, price);
+        if (error != std::errc() || last != end) {
+          fail("Price \"" + field + "\" is not a number");
+        }
+        book.price(price);
+        break;
+      }
+      case CsvColumn::IGNORE:
+        break;
+    }
+  }
+  return true;
+}
+
+std::size_t BookCsvReader::records() const {
+  return records_;
+}
+
+bool BookCsvReader::read_record() {
+  std::streambuf& in = *stream_.rdbuf();
+  constexpr int end_of_file = std::char_traits<char>::eof();
+  if (in.sgetc() == end_of_file) {
+    stream_.setstate(std::ios_base::eofbit);
+    return false;
+  }
+  ++records_;
+
+  // Starts the next field, reusing a string from an earlier record if there
+  // is one.
+  field_count_ = 0;
+  auto next_field = [this]() -> std::string& {
+    if (field_count_ == fields_.size()) {
+      fields_.emplace_back();
+    }
+    std::string& field = fields_[field_count_++];
+    field.clear();
+    return field;
+  };
+
+  std::string* field = &next_field();
+  bool field_started = false;
+  blank_line_ = true;
+  for (int c = in.sbumpc(); c != end_of_file; c = in.sbumpc()) {
+    const char ch = static_cast<char>(c);
+    if (ch != '\n' && ch != '\r') {
+      blank_line_ = false;
+    }
+    if (ch == '"' && !field_started) {
+      // A quoted field runs to the next quote that is not doubled.
+      field_started = true;
+      for (;;) {
+        const int quoted = in.sbumpc();
+        if (quoted == end_of_file) {
+          fail("Quoted field is not closed");
+        }
+        if (quoted == '"') {
+          if (in.sgetc() != '"') {
+            break;
+          }
+          in.sbumpc();
+        }
+        *field += static_cast<char>(quoted);
+      }
+    } else if (ch == format_.delimiter) {
+      field = &next_field();
+      field_started = false;
+    } else if (ch == '\n') {
+      return true;
+    } else if (ch == '\r') {
+      if (in.sgetc() == '\n') {
+        in.sbumpc();
+      }
+      return true;
+    } else {
+      field_started = true;
+      *field += ch;
+    }
+  }
+  return true;
+}
+
+void BookCsvReader::fail(const std::string& message) const {
+  throw CsvException(message + " in CSV record "
+                     + std::to_string(records_));
+}
+
+//
+// Writing
+//
+
+BookCsvWriter::BookCsvWriter(std::ostream& stream, CsvFormat format)
+    : stream_(stream), format_(std::move(format)) {
+  if (format_.header) {
+    for (std::size_t i = 0; i < format_.columns.size(); ++i) {
+      if (i > 0) {
+        record_ += format_.delimiter;
+      }
+      append_field(name_of(format_.columns[i]));
+    }
+    end_record();
+  }
+}
+
+BookCsvWriter& BookCsvWriter::write(const Book& book) {
+  for (std::size_t i = 0; i < format_.columns.size(); ++i) {
+    if (i > 0) {
+      record_ += format_.delimiter;
+    }
+    switch (format_.columns[i]) {
+      case CsvColumn::ISBN:
+        append_field(book.isbn());
+        break;
+      case CsvColumn::TITLE:
+        append_field(book.title());
+        break;
+      case CsvColumn::AUTHOR:
+        append_field(book.author());
+        break;
+      case CsvColumn::PRICE: {
+        // The shortest form that reads back as the same price.
+        char digits[32];
+        auto [end, error] =
+            std::to_chars(digits, digits + sizeof digits, book.price());
+        record_.append(digits, end);
+        break;
+      }
+      case CsvColumn::IGNORE:
+        break;
+    }
+  }
+  end_record();
+  return *this;
+}
+
+BookCsvWriter& BookCsvWriter::write(const BookList& book_list) {
+  for (const Book& book : book_list) {
+    write(book);
+  }
+  return *this;
+}
+
+void BookCsvWriter::append_field(const std::string& field) {
+  const char specials[] = {format_.delimiter, '"', '\r', '\n'};
+  if (field.find_first_of(specials, 0, sizeof specials) == std::string::npos) {
+    record_ += field;
+    return;
+  }
+  record_ += '"';
+  for (char c : field) {
+    if (c == '"') {
+      record_ += '"';
+    }
+    record_ += c;
+  }
+  record_ += '"';
+}
+
+void BookCsvWriter::end_record() {
+  record_ += "\r\n";
+  stream_.write(record_.data(), static_cast<std::streamsize>(record_.size()));
+  record_.clear();
+}
+
+//
+// Whole Lists
+//
+
+std::size_t read_csv(std::istream& stream, BookList& book_list,
+                     CsvFormat format) {
+  BookCsvReader reader(stream, std::move(format));
+  return book_list.append_unique(
+      [&reader](Book& book) { return reader.next(book); });
+}
+
+void write_csv(std::ostream& stream, const BookList& book_list,
+               CsvFormat format) {
+  BookCsvWriter(stream, std::move(format)).write(book_list);
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#ifndef _book_csv_hpp_
+#define _book_csv_hpp_
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// Streaming import and export of books as comma-separated values, following
+// RFC 4180: fields containing the delimiter, a quote, or a line break are
+// quoted, and quotes inside them are doubled. Only one record is held in
+// memory at a time, whatever the size of the file.
+
+// The book field held by a CSV column.
+enum class CsvColumn { ISBN, TITLE, AUTHOR, PRICE, IGNORE };
+
+// How books are laid out in a CSV file.
+struct CsvFormat {
+  // The columns in file order. When reading a file with a header, the header
+  // decides the columns instead.
+  std::vector<CsvColumn> columns = {CsvColumn::ISBN, CsvColumn::TITLE,
+                                    CsvColumn::AUTHOR, CsvColumn::PRICE};
+
+  // Whether the first record names the columns.
+  bool header = true;
+
+  // The character separating fields.
+  char delimiter = ',';
+};
+
+// Thrown if a CSV file is malformed.
+struct CsvException : std::runtime_error {
+  using runtime_error::runtime_error;
+};
+
+// The BookCsvReader class reads books one record at a time from a stream.
+//
+// Header names are matched case-insensitively against "isbn", "title",
+// "author", and "price"; other columns are skipped. Fields a record lacks are
+// left empty, or zero for the price, and blank lines are skipped.
+class BookCsvReader {
+ public:
+  // Reads from stream, which must outlive the reader, laid out as format.
+  explicit BookCsvReader(std::istream& stream, CsvFormat format = {});
+
+  // Reads the next book into book, returning false at the end of the stream.
+  //
+  // Throws CsvException if a price is not a number or a quote is not closed.
+  bool next(Book& book);
+
+  // Returns the number of records read so far, including any header.
+  std::size_t records() const;
+
+ private:
+  // Reads the next record's fields into fields_, returning false at the end
+  // of the stream, and notes in blank_line_ whether the record was empty.
+  bool read_record();
+
+  // Throws CsvException with message and the current record number.
+  [[noreturn]] void fail(const std::string& message) const;
+
+  // The stream read from.
+  std::istream& stream_;
+
+  // The layout of the file.
+  CsvFormat format_;
+
+  // Whether the header, if any, is still to be read.
+  bool header_pending_ = false;
+
+  // The fields of the current record. Only the first field_count_ are in use;
+  // the rest keep their capacity for later records.
+  std::vector<std::string> fields_;
+  std::size_t field_count_ = 0;
+
+  // Whether the current record's line held no characters at all.
+  bool blank_line_ = false;
+
+  // The number of records read.
+  std::size_t records_ = 0;
+};
+
+// The BookCsvWriter class writes books one record at a time to a stream, with
+// records ending in CRLF as RFC 4180 specifies.
+class BookCsvWriter {
+ public:
+  // Writes to stream, which must outlive the writer, laid out as format. The
+  // header, if any, is written straight away.
+  explicit BookCsvWriter(std::ostream& stream, CsvFormat format = {});
+
+  // Writes book as one record.
+  BookCsvWriter& write(const Book& book);
+
+  // Writes every book in book_list, top to bottom.
+  BookCsvWriter& write(const BookList& book_list);
+
+ private:
+  // Appends field to record_, quoting it if needed.
+  void append_field(const std::string& field);
+
+  // Writes record_ to the stream as a complete record.
+  void end_record();
+
+  // The stream written to.
+  std::ostream& stream_;
+
+  // The layout of the file.
+  CsvFormat format_;
+
+  // The record being built, reused between records.
+  std::string record_;
+};
+
+// Adds each book read from stream to the bottom of book_list, skipping books
+// it already holds, and returns the number of records read.
+//
+// Throws as BookCsvReader::next() and BookList::append_unique() do.
+std::size_t read_csv(std::istream& stream, BookList& book_list,
+                     CsvFormat format = {});
+
+// Writes book_list to stream laid out as format.
+void write_csv(std::ostream& stream, const BookList& book_list,
+               CsvFormat format = {});
+
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+// Unit tests for CSV import and export.
+
+#include <sstream>
+#include <string>
+
+#include "book.hpp"
+#include "book_csv.hpp"
+#include "book_list.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("Csv") {
+  const Book book_1("Programming with C++", "Diane Zak", "9780064430173", 31.99),
+      book_2("Say \"Hi\", then\nleave", "Smith, Jo", "2", 0.1),
+      book_3("", "", "", 0.0);
+
+  SUBCASE("RoundTrip") {
+    const BookList list = {book_1, book_2, book_3};
+    std::stringstream stream;
+    write_csv(stream, list);
+    CHECK_EQ("isbn,title,author,price\r\n"
+             "9780064430173,Programming with C++,Diane Zak,31.99\r\n"
+             "2,\"Say \"\"Hi\"\", then\nleave\",\"Smith, Jo\",0.1\r\n"
+             ",,,0\r\n",
+             stream.str());
+
+    BookList read;
+    CHECK_EQ(3U, read_csv(stream, read));
+    CHECK_EQ(list, read);
+  }
+
+  SUBCASE("Header") {
+    // Columns come from the header, in any order, and unknown ones are
+    // skipped.
+    std::istringstream stream(
+        "Price;Notes;TITLE\n"
+        "31.99;\"a;b\";Programming with C++\n"
+        "\n"
+        "8.5;;\"Goodnight Moon\"\r\n");
+    BookCsvReader reader(stream, {.delimiter = ';'});
+    Book book;
+    REQUIRE(reader.next(book));
+    CHECK_EQ(Book("Programming with C++", "", "", 31.99), book);
+    REQUIRE(reader.next(book));
+    CHECK_EQ(Book("Goodnight Moon", "", "", 8.5), book);
+    CHECK_FALSE(reader.next(book));
+    CHECK_EQ(4U, reader.records());
+  }
+
+  SUBCASE("Columns") {
+    const CsvFormat format = {
+        {CsvColumn::TITLE, CsvColumn::IGNORE, CsvColumn::PRICE}, false};
+    std::stringstream stream;
+    BookCsvWriter(stream, format).write(book_1);
+    CHECK_EQ("Programming with C++,,31.99\r\n", stream.str());
+
+    Book book;
+    BookCsvReader reader(stream, format);
+    REQUIRE(reader.next(book));
+    CHECK_EQ(Book("Programming with C++", "", "", 31.99), book);
+  }
+
+  SUBCASE("EmptyQuotedField") {
+    // A record of one empty quoted field is a book, not a blank line.
+    std::istringstream stream("title\n\"\"\n\nLast\n");
+    BookCsvReader reader(stream);
+    Book book("placeholder");
+    REQUIRE(reader.next(book));
+    CHECK_EQ(Book(), book);
+    REQUIRE(reader.next(book));
+    CHECK_EQ(Book("Last"), book);
+    CHECK_FALSE(reader.next(book));
+  }
+
+  SUBCASE("SkipsHeldBooks") {
+    BookList list = {book_1};
+    std::stringstream stream;
+    BookCsvWriter(stream).write(book_1).write(book_2).write(book_2);
+    CHECK_EQ(3U, read_csv(stream, list));
+    CHECK_EQ(BookList({book_1, book_2}), list);
+  }
+
+  SUBCASE("TooManyBooks") {
+    // The books are added as one batch, so a file that overflows the list
+    // adds none of them.
+    BookList list;
+    std::stringstream stream;
+    BookCsvWriter writer(stream);
+    for (int i = 0; i < 12; ++i) {
+      const Book book("title " + std::to_string(i));
+      writer.write(book);
+      if (i < 10) {
+        list.insert(book, BookList::Position::BOTTOM);
+      }
+    }
+    const BookList before = list;
+    CHECK_THROWS_AS(read_csv(stream, list),
+                    BookList::CapacityExceededException);
+    CHECK_EQ(before, list);
+  }
+
+  SUBCASE("Malformed") {
+    Book book;
+    std::istringstream bad_price("price\nabc\n");
+    BookCsvReader price_reader(bad_price);
+    CHECK_THROWS_AS(price_reader.next(book), CsvException);
+
+    std::istringstream open_quote("title\n\"never closed\n");
+    BookCsvReader quote_reader(open_quote);
+    CHECK_THROWS_AS(quote_reader.next(book), CsvException);
+  }
+}
\ No newline at end of file
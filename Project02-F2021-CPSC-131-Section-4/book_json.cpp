@@ -0,0 +1,495 @@
+#include "book_json.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+namespace {
+
+// The deepest nesting parse_json() accepts, which bounds its recursion.
+constexpr std::size_t max_depth = 256;
+
+// The size at which buffered output is handed to the stream.
+constexpr std::size_t flush_size = 1 << 16;
+
+constexpr int end_of_file = std::char_traits<char>::eof();
+
+// Parses one JSON value at a time from a stream buffer.
+class Parser {
+ public:
+  Parser(std::streambuf& in, JsonHandler& handler)
+      : in_(in), handler_(handler) {}
+
+  void parse_value(std::size_t depth) {
+    if (depth > max_depth) {
+      throw JsonException("JSON nested too deeply");
+    }
+    skip_whitespace();
+    const int c = in_.sgetc();
+    switch (c) {
+      case '{':
+        parse_object(depth);
+        break;
+      case '[':
+        parse_array(depth);
+        break;
+      case '"':
+        handler_.string_value(parse_string());
+        break;
+      case 't':
+        expect_word("true");
+        handler_.bool_value(true);
+        break;
+      case 'f':
+        expect_word("false");
+        handler_.bool_value(false);
+        break;
+      case 'n':
+        expect_word("null");
+        handler_.null_value();
+        break;
+      default:
+        if (c == '-' || (c >= '0' && c <= '9')) {
+          handler_.number_value(parse_number());
+        } else {
+          throw JsonException("Unexpected character in JSON value");
+        }
+    }
+  }
+
+ private:
+  void parse_object(std::size_t depth) {
+    in_.sbumpc();
+    handler_.start_object();
+    skip_whitespace();
+    if (in_.sgetc() == '}') {
+      in_.sbumpc();
+      handler_.end_object();
+      return;
+    }
+    for (;;) {
+      skip_whitespace();
+      if (in_.sgetc() != '"') {
+        throw JsonException("Expected a member name in JSON object");
+      }
+      handler_.key(parse_string());
+      expect(':');
+      parse_value(depth + 1);
+      skip_whitespace();
+      const int c = in_.sbumpc();
+      if (c == '}') {
+        break;
+      }
+      if (c != ',') {
+        throw JsonException("Expected ',' or '}' in JSON object");
+      }
+    }
+    handler_.end_object();
+  }
+
+  void parse_array(std::size_t depth) {
+    in_.sbumpc();
+    handler_.start_array();
+    skip_whitespace();
+    if (in_.sgetc() == ']') {
+      in_.sbumpc();
+      handler_.end_array();
+      return;
+    }
+    for (;;) {
+      parse_value(depth + 1);
+      skip_whitespace();
+      const int c = in_.sbumpc();
+      if (c == ']') {
+        break;
+      }
+      if (c != ',') {
+        throw JsonException("Expected ',' or ']' in JSON array");
+      }
+    }
+    handler_.end_array();
+  }
+
+  // Returns the string starting at the opening quote, with escapes decoded
+  // and \u escapes written as UTF-8. The buffer is reused between strings.
+  const std::string& parse_string() {
+    in_.sbumpc();
+    text_.clear();
+    for (;;) {
+      const int c = in_.sbumpc();
+      if (c == end_of_file) {
+        throw JsonException("JSON string is not closed");
+      }
+      if (c == '"') {
+        return text_;
+      }
+      if (c != '\\') {
+        if (static_cast<unsigned char>(c) < 0x20) {
+          throw JsonException("Control character in JSON string");
+        }
+        text_ += static_cast<char>(c);
+        continue;
+      }
+      switch (in_.sbumpc()) {
+        case '"':
+          text_ += '"';
+          break;
+        case '\\':
+          text_ += '\\';
+          break;
+        case '/':
+          text_ += '/';
+          break;
+        case 'b':
+          text_ += '\b';
+          break;
+        case 'f':
+          text_ += '\f';
+          break;
+        case 'n':
+          text_ += '\n';
+          break;
+        case 'r':
+          text_ += '\r';
+          break;
+        case 't':
+          text_ += '\t';
+          break;
+        case 'u':
+          append_code_point(parse_code_point());
+          break;
+        default:
+          throw JsonException("Bad escape in JSON string");
+      }
+    }
+  }
+
+  // Returns the code point of a \u escape whose "\u" has been read, joining
+  // a surrogate pair into one code point.
+  std::uint32_t parse_code_point() {
+    std::uint32_t code_point = parse_hex4();
+    if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+      if (in_.sbumpc() != '\\' || in_.sbumpc() != 'u') {
+        throw JsonException("Unpaired surrogate in JSON string");
+      }
+      const std::uint32_t low = parse_hex4();
+      if (low < 0xDC00 || low > 0xDFFF) {
+        throw JsonException("Unpaired surrogate in JSON string");
+      }
+      code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+    } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+      throw JsonException("Unpaired surrogate in JSON string");
+    }
+    return code_point;
+  }
+
+  std::uint32_t parse_hex4() {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+      const int c = in_.sbumpc();
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= static_cast<std::uint32_t>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        value |= static_cast<std::uint32_t>(c - 'a' + 10);
+      } else if (c >= 'A' && c <= 'F') {
+        value |= static_cast<std::uint32_t>(c - 'A' + 10);
+      } else {
+        throw JsonException("Bad \\u escape in JSON string");
+      }
+    }
+    return value;
+  }
+
+  void append_code_point(std::uint32_t code_point) {
+    if (code_point < 0x80) {
+      text_ += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      text_ += static_cast<char>(0xC0 | (code_point >> 6));
+      text_ += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      text_ += static_cast<char>(0xE0 | (code_point >> 12));
+      text_ += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      text_ += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+      text_ += static_cast<char>(0xF0 | (code_point >> 18));
+      text_ += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      text_ += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      text_ += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  double parse_number() {
+    text_.clear();
+    for (int c = in_.sgetc();
+         c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E'
+         || (c >= '0' && c <= '9');
+         c = in_.sgetc()) {
+      text_ += static_cast<char>(in_.sbumpc());
+    }
+    double value = 0.0;
+    const char* end = text_.data() + text_.size();
+    auto [last, error] = std::from_chars(text_.data(), end, value);
+    if (error != std::errc() || last != end) {
+      throw JsonException("Bad JSON number \"" + text_ + "\"");
+    }
+    return value;
+  }
+
+  void expect_word(const char* word) {
+    for (const char* c = word; *c != '\0'; ++c) {
+      if (in_.sbumpc() != *c) {
+        throw JsonException(std::string("Expected \"") + word + "\" in JSON");
+      }
+    }
+  }
+
+  void expect(char c) {
+    skip_whitespace();
+    if (in_.sbumpc() != c) {
+      throw JsonException(std::string("Expected '") + c + "' in JSON");
+    }
+  }
+
+  void skip_whitespace() {
+    for (int c = in_.sgetc(); c == ' ' || c == '\t' || c == '\n' || c == '\r';
+         c = in_.snextc()) {
+    }
+  }
+
+  std::streambuf& in_;
+  JsonHandler& handler_;
+
+  // The text of the string or number being parsed.
+  std::string text_;
+};
+
+// Builds books from the events of an array of book objects, collecting each
+// as its object ends.
+class BookListBuilder : public JsonHandler {
+ public:
+  const std::vector<Book>& books() const { return books_; }
+
+  void start_object() override {
+    ++depth_;
+    if (depth_ == 1) {
+      throw JsonException("Expected a JSON array of books");
+    }
+    if (depth_ == 2) {
+      book_ = Book();
+    }
+  }
+
+  void key(const std::string& name) override {
+    if (depth_ == 2) {
+      key_ = name;
+    }
+  }
+
+  void end_object() override {
+    if (depth_ == 2) {
+      books_.push_back(book_);
+    }
+    --depth_;
+  }
+
+  void start_array() override {
+    ++depth_;
+    if (depth_ == 2) {
+      throw JsonException("Expected a JSON object for each book");
+    }
+  }
+
+  void end_array() override { --depth_; }
+
+  void string_value(const std::string& value) override {
+    if (depth_ != 2) {
+      scalar();
+      return;
+    }
+    if (key_ == "isbn") {
+      book_.isbn(value);
+    } else if (key_ == "title") {
+      book_.title(value);
+    } else if (key_ == "author") {
+      book_.author(value);
+    } else if (key_ == "price") {
+      throw JsonException("Book price must be a JSON number");
+    }
+  }
+
+  void number_value(double value) override {
+    if (depth_ != 2) {
+      scalar();
+      return;
+    }
+    if (key_ == "price") {
+      book_.price(value);
+    } else if (key_ == "isbn" || key_ == "title" || key_ == "author") {
+      throw JsonException("Book " + key_ + " must be a JSON string");
+    }
+  }
+
+  void bool_value(bool) override { scalar(); }
+
+  void null_value() override { scalar(); }
+
+ private:
+  // Rejects a scalar standing where the array or a book belongs. Scalars
+  // inside a book are ignored unless they are a book field.
+  void scalar() const {
+    if (depth_ == 0) {
+      throw JsonException("Expected a JSON array of books");
+    }
+    if (depth_ == 1) {
+      throw JsonException("Expected a JSON object for each book");
+    }
+  }
+
+  std::vector<Book> books_;
+  Book book_;
+  std::string key_;
+  std::size_t depth_ = 0;
+};
+
+// Collects JSON text and hands it to a stream in large blocks. Whatever is
+// left over must be flushed explicitly, so a document abandoned by an
+// exception is not half written.
+class Writer {
+ public:
+  explicit Writer(std::ostream& stream) : stream_(stream) {
+    buffer_.reserve(flush_size);
+  }
+
+  void write(const Book& book) {
+    buffer_ += "{\"isbn\":";
+    append_string(book.isbn());
+    buffer_ += ",\"title\":";
+    append_string(book.title());
+    buffer_ += ",\"author\":";
+    append_string(book.author());
+    buffer_ += ",\"price\":";
+
+    if (!std::isfinite(book.price())) {
+      throw JsonException("JSON cannot hold the price of book \""
+                          + book.title() + "\"");
+    }
+    char digits[32];
+    auto [end, error] =
+        std::to_chars(digits, digits + sizeof digits, book.price());
+    buffer_.append(digits, end);
+    buffer_ += '}';
+
+    if (buffer_.size() >= flush_size) {
+      flush();
+    }
+  }
+
+  void append(char c) { buffer_ += c; }
+
+  void flush() {
+    stream_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+  }
+
+ private:
+  // Appends text as a JSON string. Runs of characters that need no escape
+  // are copied in one append rather than character by character.
+  void append_string(const std::string& text) {
+    static constexpr char hex[] = "0123456789abcdef";
+    buffer_ += '"';
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      const unsigned char c = static_cast<unsigned char>(text[i]);
+      if (c >= 0x20 && c != '"' && c != '\\') {
+        continue;
+      }
+      buffer_.append(text, run, i - run);
+      run = i + 1;
+      switch (c) {
+        case '"':
+          buffer_ += "\\\"";
+          break;
+        case '\\':
+          buffer_ += "\\\\";
+          break;
+        case '\n':
+          buffer_ += "\\n";
+          break;
+        case '\r':
+          buffer_ += "\\r";
+          break;
+        case '\t':
+          buffer_ += "\\t";
+          break;
+        default:
+          buffer_ += "\\u00";
+          buffer_ += hex[c >> 4];
+          buffer_ += hex[c & 0xF];
+      }
+    }
+    buffer_.append(text, run, text.size() - run);
+    buffer_ += '"';
+  }
+
+  std::ostream& stream_;
+  std::string buffer_;
+};
+
+}  // namespace
+
+//
+// Reading
+//
+
+void parse_json(std::istream& stream, JsonHandler& handler) {
+  Parser(*stream.rdbuf(), handler).parse_value(0);
+}
+
+std::size_t read_json(std::istream& stream, BookList& book_list) {
+  // Parse the whole document first, then add its books as one batch, as
+  // read_csv() does.
+  BookListBuilder builder;
+  parse_json(stream, builder);
+  auto book = builder.books().begin();
+  return book_list.append_unique([&](Book& next) {
+    if (book == builder.books().end()) {
+      return false;
+    }
+    next = *book++;
+    return true;
+  });
+}
+
+//
+// Writing
+//
+
+void write_json(std::ostream& stream, const Book& book) {
+  Writer writer(stream);
+  writer.write(book);
+  writer.flush();
+}
+
+void write_json(std::ostream& stream, const BookList& book_list) {
+  Writer writer(stream);
+  writer.append('[');
+  bool first = true;
+  for (const Book& book : book_list) {
+    if (!first) {
+      writer.append(',');
+    }
+    first = false;
+    writer.write(book);
+  }
+  writer.append(']');
+  writer.flush();
+}
\ No newline at end of file
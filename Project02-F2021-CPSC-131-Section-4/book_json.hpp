@@ -0,0 +1,65 @@
+#ifndef _book_json_hpp_
+#define _book_json_hpp_
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// Streaming JSON import and export of books. A book is an object with
+// "isbn", "title", and "author" strings and a "price" number; a book list is
+// an array of books, top to bottom.
+//
+// The reader is event based: parse_json() reports each value to a JsonHandler
+// as it is read, and never builds a tree of the document.
+
+// Thrown if a JSON document is malformed or does not describe books.
+struct JsonException : std::runtime_error {
+  using runtime_error::runtime_error;
+};
+
+// The JsonHandler class receives the events of a document being parsed. Each
+// method does nothing unless overridden.
+class JsonHandler {
+ public:
+  virtual ~JsonHandler() = default;
+
+  virtual void start_object() {}
+  virtual void key(const std::string& /*name*/) {}
+  virtual void end_object() {}
+  virtual void start_array() {}
+  virtual void end_array() {}
+  virtual void string_value(const std::string& /*value*/) {}
+  virtual void number_value(double /*value*/) {}
+  virtual void bool_value(bool /*value*/) {}
+  virtual void null_value() {}
+};
+
+// Reads one JSON value from stream, reporting it to handler.
+//
+// Throws JsonException if the value is malformed or nested too deeply.
+void parse_json(std::istream& stream, JsonHandler& handler);
+
+// Adds each book in the JSON array read from stream to the bottom of
+// book_list, skipping books it already holds, and returns the number of books
+// read. Members other than the four book fields are ignored. The books are
+// added as one batch once the whole array has been read.
+//
+// Throws JsonException, leaving book_list unchanged, if the document is not
+// an array of books, and throws as BookList::append_unique() does.
+std::size_t read_json(std::istream& stream, BookList& book_list);
+
+// Writes book to stream as a JSON object.
+//
+// Throws JsonException if the price is infinite or not a number.
+void write_json(std::ostream& stream, const Book& book);
+
+// Writes book_list to stream as a JSON array of books.
+//
+// Throws JsonException if a price is infinite or not a number.
+void write_json(std::ostream& stream, const BookList& book_list);
+
+#endif
\ No newline at end of file
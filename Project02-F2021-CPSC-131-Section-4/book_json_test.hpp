@@ -0,0 +1,104 @@
+// Unit tests for JSON import and export.
+
+#include <sstream>
+#include <string>
+
+#include "book.hpp"
+#include "book_json.hpp"
+#include "book_list.hpp"
+#include "doctest.hpp"
+
+namespace {
+
+// Records each event as a short token.
+struct EventRecorder : JsonHandler {
+  void start_object() override { events += "{"; }
+  void key(const std::string& name) override { events += name + ":"; }
+  void end_object() override { events += "}"; }
+  void start_array() override { events += "["; }
+  void end_array() override { events += "]"; }
+  void string_value(const std::string& value) override {
+    events += "'" + value + "' ";
+  }
+  void number_value(double value) override {
+    events += std::to_string(static_cast<int>(value)) + " ";
+  }
+  void bool_value(bool value) override { events += value ? "T " : "F "; }
+  void null_value() override { events += "N "; }
+
+  std::string events;
+};
+
+}  // namespace
+
+TEST_CASE("Json") {
+  const Book book_1("Programming with C++", "Diane Zak", "9780064430173", 31.99),
+      book_2("Say \"Hi\"\n\tthen \\ leave\x01", "Jo", "2", 0.1),
+      book_3("", "", "", 0.0);
+
+  SUBCASE("RoundTrip") {
+    const BookList list = {book_1, book_2, book_3};
+    std::stringstream stream;
+    write_json(stream, list);
+    CHECK_EQ("[{\"isbn\":\"9780064430173\",\"title\":\"Programming with C++\","
+             "\"author\":\"Diane Zak\",\"price\":31.99},"
+             "{\"isbn\":\"2\",\"title\":"
+             "\"Say \\\"Hi\\\"\\n\\tthen \\\\ leave\\u0001\","
+             "\"author\":\"Jo\",\"price\":0.1},"
+             "{\"isbn\":\"\",\"title\":\"\",\"author\":\"\",\"price\":0}]",
+             stream.str());
+
+    BookList read;
+    CHECK_EQ(3U, read_json(stream, read));
+    CHECK_EQ(list, read);
+
+    std::ostringstream empty;
+    write_json(empty, BookList());
+    CHECK_EQ("[]", empty.str());
+  }
+
+  SUBCASE("Events") {
+    std::istringstream stream(
+        " { \"a\" : [ 1 , -2.5e1 , true , false , null ] ,\n"
+        "   \"b\" : { } , \"c\" : \"x\\u00e9\\ud83d\\ude00\" } ");
+    EventRecorder recorder;
+    parse_json(stream, recorder);
+    CHECK_EQ("{a:[1 -25 T F N ]b:{}c:'x\xc3\xa9\xf0\x9f\x98\x80' }",
+             recorder.events);
+  }
+
+  SUBCASE("ExtraMembers") {
+    std::istringstream stream(
+        "[{\"price\": 8.5, \"tags\": [\"kids\", {\"age\": 3}], "
+        "\"title\": \"Goodnight Moon\", \"inStock\": true}]");
+    BookList read;
+    CHECK_EQ(1U, read_json(stream, read));
+    CHECK_EQ(BookList({Book("Goodnight Moon", "", "", 8.5)}), read);
+  }
+
+  SUBCASE("Malformed") {
+    for (const char* text :
+         {"{\"title\": \"x\"}", "[1]", "[[]]", "[{\"price\": \"1\"}]",
+          "[{\"title\": 1}]", "[{\"title\": \"x\"", "[{\"title\" \"x\"}]",
+          "[{\"title\": \"x\\q\"}]", "[{\"title\": \"\\ud800\"}]",
+          "[{\"price\": 1..2}]", "[tru]"}) {
+      std::istringstream stream(text);
+      BookList read;
+      CHECK_THROWS_AS(read_json(stream, read), JsonException);
+    }
+
+    // Books read before the error are not added.
+    std::istringstream truncated("[{\"title\": \"x\"}, {\"title\": 1}]");
+    BookList read;
+    CHECK_THROWS_AS(read_json(truncated, read), JsonException);
+    CHECK_EQ(BookList(), read);
+
+    std::istringstream deep(std::string(1000, '['));
+    EventRecorder recorder;
+    CHECK_THROWS_AS(parse_json(deep, recorder), JsonException);
+
+    std::ostringstream stream;
+    CHECK_THROWS_AS(write_json(stream, Book("x", "", "", 1.0 / 0.0)),
+                    JsonException);
+  }
+}
\ No newline at end of file
@@ -1,13 +1,341 @@
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <iomanip>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <ranges>
 #include <stdexcept>
+#include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "book.hpp"
 #include "book_list.hpp"
+#include "isbn.hpp"
+#include "price_kernels.hpp"
+
+namespace {
+
+// Splits text into lowercase words made of letters and digits, appending them
+// to words.
+void append_words(const std::string& text, std::vector<std::string>& words) {
+  std::string word;
+  for (char c : text) {
+    if (std::isalnum(static_cast<unsigned char>(c))) {
+      word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    } else if (!word.empty()) {
+      words.push_back(std::move(word));
+      word.clear();
+    }
+  }
+  if (!word.empty()) {
+    words.push_back(std::move(word));
+  }
+}
+
+// Returns the distinct words of a book's title and author, sorted.
+std::vector<std::string> words_of(const Book& book) {
+  std::vector<std::string> words;
+  append_words(book.title(), words);
+  append_words(book.author(), words);
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+  return words;
+}
+
+// Encodes ascending offsets into bytes as the varint-encoded gaps between
+// them, replacing what bytes held.
+void encode_postings(const std::vector<std::size_t>& offsets,
+                     std::pmr::string& bytes) {
+  bytes.clear();
+  std::size_t previous = 0;
+  for (std::size_t offset : offsets) {
+    std::size_t gap = offset - previous;
+    previous = offset;
+    while (gap >= 0x80) {
+      bytes += static_cast<char>((gap & 0x7F) | 0x80);
+      gap >>= 7;
+    }
+    bytes += static_cast<char>(gap);
+  }
+}
+
+// Decodes the offsets written by encode_postings.
+std::vector<std::size_t> decode_postings(std::string_view bytes) {
+  std::vector<std::size_t> offsets;
+  std::size_t previous = 0;
+  std::size_t gap = 0;
+  int shift = 0;
+  for (char c : bytes) {
+    const auto byte = static_cast<unsigned char>(c);
+    gap |= static_cast<std::size_t>(byte & 0x7F) << shift;
+    if (byte & 0x80) {
+      shift += 7;
+    } else {
+      previous += gap;
+      offsets.push_back(previous);
+      gap = 0;
+      shift = 0;
+    }
+  }
+  return offsets;
+}
+
+// Returns the value stored under key in an index keyed by std::pmr::string,
+// adding a default one if there is none. Unlike operator[], it builds a key
+// only when adding.
+template <typename Index>
+typename Index::mapped_type& entry_for(Index& index, std::string_view key) {
+  auto entry = index.find(key);
+  if (entry == index.end()) {
+    entry = index.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple()).first;
+  }
+  return entry->second;
+}
+
+// Returns a copy of index allocating from resource.
+template <typename Index>
+Index copy_into(const Index& index, std::pmr::memory_resource* resource) {
+  return Index(index, resource);
+}
+
+// Returns, for each character, the bit mask of the positions where it occurs
+// in pattern, for patterns of up to 64 characters. Longer patterns get an
+// empty table, since within_edits does not use it for them.
+std::array<std::uint64_t, 256> pattern_masks(const std::string& pattern) {
+  std::array<std::uint64_t, 256> peq{};
+  if (pattern.size() <= 64) {
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+      peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t{1} << i;
+    }
+  }
+  return peq;
+}
+
+// Returns whether the edit distance between pattern and text is at most
+// max_edits, where peq is pattern_masks(pattern).
+//
+// Patterns of up to 64 characters use Hyyro's bit-parallel form of Myers'
+// algorithm, which advances a whole column of the edit distance matrix with a
+// handful of word operations per text character. Longer patterns fall back to
+// the dynamic programming recurrence one row at a time, in row, which callers
+// keep across texts so that it is allocated only when it must grow.
+bool within_edits(const std::string& pattern,
+                  const std::array<std::uint64_t, 256>& peq,
+                  const std::string& text, std::size_t max_edits,
+                  std::vector<std::size_t>& row) {
+  const std::size_t m = pattern.size();
+  const std::size_t n = text.size();
+
+  // The distance is at least the difference in length.
+  if ((m > n ? m - n : n - m) > max_edits) {
+    return false;
+  }
+  if (m == 0) {
+    return n <= max_edits;
+  }
+
+  if (m <= 64) {
+    const std::uint64_t last = std::uint64_t{1} << (m - 1);
+    std::uint64_t pv = ~std::uint64_t{0};
+    std::uint64_t mv = 0;
+    std::size_t score = m;
+    for (std::size_t j = 0; j < n; ++j) {
+      const std::uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+      const std::uint64_t xv = eq | mv;
+      const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+      std::uint64_t ph = mv | ~(xh | pv);
+      std::uint64_t mh = pv & xh;
+      if (ph & last) {
+        ++score;
+      } else if (mh & last) {
+        --score;
+      }
+      ph = (ph << 1) | 1;
+      mh <<= 1;
+      pv = mh | ~(xv | ph);
+      mv = ph & xv;
+
+      // Each remaining character can lower the score by at most one.
+      if (score > max_edits + (n - j - 1)) {
+        return false;
+      }
+    }
+    return score <= max_edits;
+  }
+
+  row.resize(n + 1);
+  for (std::size_t j = 0; j <= n; ++j) {
+    row[j] = j;
+  }
+  for (std::size_t i = 1; i <= m; ++i) {
+    std::size_t diagonal = row[0];
+    row[0] = i;
+    std::size_t row_minimum = row[0];
+    for (std::size_t j = 1; j <= n; ++j) {
+      const std::size_t above = row[j];
+      row[j] = std::min({above + 1, row[j - 1] + 1,
+                         diagonal + (pattern[i - 1] == text[j - 1] ? 0 : 1)});
+      diagonal = above;
+      row_minimum = std::min(row_minimum, row[j]);
+    }
+    // Distances never decrease from one row to the next.
+    if (row_minimum > max_edits) {
+      return false;
+    }
+  }
+  return row[n] <= max_edits;
+}
+
+// Returns whether lhs comes before rhs by key alone, so that books with equal
+// keys compare equal.
+bool key_less(BookList::SortKey key, const Book& lhs, const Book& rhs) {
+  switch (key) {
+    case BookList::SortKey::TITLE:
+      return lhs.title() < rhs.title();
+    case BookList::SortKey::AUTHOR:
+      return lhs.author() < rhs.author();
+    case BookList::SortKey::ISBN:
+      return lhs.isbn() < rhs.isbn();
+    case BookList::SortKey::PRICE:
+      return lhs.price() < rhs.price();
+  }
+  return false;
+}
+
+// Swaps two containers together with their allocators.
+//
+// pmr containers never propagate their allocators, so trading storage
+// between containers on different resources means rebuilding each one in
+// place around the other's storage. Moving a container takes its allocator
+// along without allocating.
+template <typename Container>
+void swap_with_allocators(Container& lhs, Container& rhs) {
+  Container temp(std::move(lhs));
+  std::destroy_at(&lhs);
+  std::construct_at(&lhs, std::move(rhs));
+  std::destroy_at(&rhs);
+  std::construct_at(&rhs, std::move(temp));
+}
+
+}  // namespace
+
+bool BookList::PriceOrder::operator()(const Book& lhs,
+                                      const Book& rhs) const noexcept {
+  if (lhs.price() != rhs.price()) {
+    return lhs.price() < rhs.price();
+  }
+  return lhs < rhs;
+}
+
+bool BookList::KeyOrder::operator()(const Book* lhs,
+                                    const Book* rhs) const noexcept {
+  switch (key) {
+    case SortKey::TITLE: {
+      if (lhs->title() != rhs->title()) {
+        return lhs->title() < rhs->title();
+      }
+      break;
+    }
+    case SortKey::AUTHOR: {
+      if (lhs->author() != rhs->author()) {
+        return lhs->author() < rhs->author();
+      }
+      break;
+    }
+    case SortKey::ISBN: {
+      if (lhs->isbn() != rhs->isbn()) {
+        return lhs->isbn() < rhs->isbn();
+      }
+      break;
+    }
+    case SortKey::PRICE: {
+      return PriceOrder()(*lhs, *rhs);
+    }
+  }
+  return *lhs < *rhs;
+}
+
+//
+// Sorted Views
+//
+
+BookList::SortedView::const_iterator::const_iterator(
+    std::pmr::set<const Book*, KeyOrder>::const_iterator position)
+    : position_(position) {}
+
+const Book& BookList::SortedView::const_iterator::operator*() const {
+  return **position_;
+}
+
+const Book* BookList::SortedView::const_iterator::operator->() const {
+  return *position_;
+}
+
+BookList::SortedView::const_iterator&
+BookList::SortedView::const_iterator::operator++() {
+  ++position_;
+  return *this;
+}
+
+BookList::SortedView::const_iterator
+BookList::SortedView::const_iterator::operator++(int) {
+  const_iterator previous = *this;
+  ++position_;
+  return previous;
+}
+
+BookList::SortedView::const_iterator&
+BookList::SortedView::const_iterator::operator--() {
+  --position_;
+  return *this;
+}
+
+BookList::SortedView::const_iterator
+BookList::SortedView::const_iterator::operator--(int) {
+  const_iterator previous = *this;
+  --position_;
+  return previous;
+}
+
+bool BookList::SortedView::const_iterator::operator==(
+    const const_iterator& rhs) const {
+  return position_ == rhs.position_;
+}
+
+bool BookList::SortedView::const_iterator::operator!=(
+    const const_iterator& rhs) const {
+  return position_ != rhs.position_;
+}
+
+BookList::SortedView::SortedView(
+    const std::pmr::set<const Book*, KeyOrder>& books)
+    : books_(&books) {}
+
+BookList::SortedView::const_iterator BookList::SortedView::begin() const {
+  return const_iterator(books_->cbegin());
+}
+
+BookList::SortedView::const_iterator BookList::SortedView::end() const {
+  return const_iterator(books_->cend());
+}
+
+std::size_t BookList::SortedView::size() const {
+  return books_->size();
+}
 
 bool BookList::containers_are_consistent() const {
   // If the sizes of the containers are not all equal, the containers are not
@@ -46,19 +374,298 @@ std::size_t BookList::books_sl_list_size() const {
   return std::distance(books_sl_list_.begin(), books_sl_list_.end());
 }
 
+BookList::ChangeFeed::ChangeFeed(const ChangeFeed&) {}
+
+BookList::ChangeFeed& BookList::ChangeFeed::operator=(const ChangeFeed&) {
+  return *this;
+}
+
+void BookList::record_change(Change::Kind kind, std::size_t offset,
+                             std::size_t to, const Book* book) {
+  ++version_;
+  if (!change_feed_.subscribers.empty()) {
+    change_feed_.pending.push_back(
+        {kind, offset, to, book != nullptr ? *book : Book()});
+  }
+}
+
+std::vector<BookList::Change> BookList::pending_with_reset(
+    const std::pmr::vector<Book>& new_books) const {
+  std::vector<Change> pending = change_feed_.pending;
+  if (change_feed_.subscribers.empty()) {
+    return pending;
+  }
+  pending.reserve(pending.size() + books_vector_.size() + new_books.size());
+  for (std::size_t i = 0; i < books_vector_.size(); ++i) {
+    pending.push_back({Change::Kind::REMOVED, 0, 0, {}});
+  }
+  for (std::size_t i = 0; i < new_books.size(); ++i) {
+    pending.push_back({Change::Kind::INSERTED, i, 0, new_books[i]});
+  }
+  return pending;
+}
+
+void BookList::record_reorder(const std::vector<std::size_t>& order) {
+  if (change_feed_.subscribers.empty()) {
+    ++version_;
+    return;
+  }
+
+  // Bring each book up to its new offset in turn, tracking where the rest
+  // have got to.
+  std::vector<std::size_t> current(order.size());
+  std::iota(current.begin(), current.end(), 0);
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    auto from = std::find(current.begin() + i, current.end(), order[i]);
+    if (from != current.begin() + i) {
+      record_change(Change::Kind::MOVED,
+                    static_cast<std::size_t>(from - current.begin()), i);
+      std::rotate(current.begin() + i, from, std::next(from));
+    }
+  }
+}
+
+void BookList::rebuild_sorted_views() {
+  sorted_views_over(books_dl_list_, node_pool_.get()).swap(sorted_views_);
+}
+
+std::array<std::pmr::set<const Book*, BookList::KeyOrder>, 4>
+BookList::sorted_views_over(const std::pmr::list<Book>& books,
+                            std::pmr::memory_resource* resource) {
+  std::array<std::pmr::set<const Book*, KeyOrder>, 4> views = {
+      std::pmr::set<const Book*, KeyOrder>(KeyOrder{SortKey::TITLE}, resource),
+      std::pmr::set<const Book*, KeyOrder>(KeyOrder{SortKey::AUTHOR},
+                                           resource),
+      std::pmr::set<const Book*, KeyOrder>(KeyOrder{SortKey::ISBN}, resource),
+      std::pmr::set<const Book*, KeyOrder>(KeyOrder{SortKey::PRICE},
+                                           resource)};
+  for (auto& view : views) {
+    for (const Book& book : books) {
+      view.insert(&book);
+    }
+  }
+  return views;
+}
+
+const std::pmr::set<const Book*, BookList::KeyOrder>&
+BookList::books_by_price() const {
+  return sorted_views_[static_cast<std::size_t>(SortKey::PRICE)];
+}
+
+void BookList::swap_indexes(BookList& rhs) {
+  swap_with_allocators(books_by_author_, rhs.books_by_author_);
+  swap_with_allocators(sorted_titles_, rhs.sorted_titles_);
+  swap_with_allocators(prices_, rhs.prices_);
+  swap_with_allocators(postings_by_word_, rhs.postings_by_word_);
+  swap_with_allocators(book_ids_, rhs.book_ids_);
+  swap_with_allocators(sorted_views_, rhs.sorted_views_);
+}
+
+void BookList::rebuild_indexes() {
+  sorted_titles_.clear();
+  for (const Book& book : books_dl_list_) {
+    sorted_titles_.emplace_back(book.title());
+  }
+  std::sort(sorted_titles_.begin(), sorted_titles_.end());
+
+  // Number the books afresh in list order. Ids are visited in ascending
+  // order, so each posting list comes out sorted.
+  postings_by_word_.clear();
+  book_ids_.clear();
+  std::map<std::string, std::vector<std::size_t>> ids_by_word;
+  for (const Book& book : books_dl_list_) {
+    const std::size_t id = book_ids_.size();
+    book_ids_.push_back(id);
+    for (const std::string& word : words_of(book)) {
+      ids_by_word[word].push_back(id);
+    }
+  }
+  for (const auto& [word, ids] : ids_by_word) {
+    encode_postings(ids, entry_for(postings_by_word_, word));
+  }
+  next_book_id_ = book_ids_.size();
+
+  reindex_offsets();
+  rebuild_sorted_views();
+}
+
+void BookList::reindex_offsets() {
+  books_by_author_.clear();
+  prices_.clear();
+
+  // Offsets are visited in ascending order, so each index's offsets come out
+  // sorted without any shifting.
+  std::size_t offset = 0;
+  for (const Book& book : books_dl_list_) {
+    entry_for(books_by_author_, book.author()).push_back(offset);
+    prices_.push_back(book.price());
+    ++offset;
+  }
+}
+
+void BookList::index_insert(const Book& book, std::size_t offset_from_top) {
+  // Every book at or below the insertion point moves down one place.
+  for (auto& [author, offsets] : books_by_author_) {
+    for (std::size_t& offset : offsets) {
+      if (offset >= offset_from_top) {
+        ++offset;
+      }
+    }
+  }
+
+  // Keep the author's offsets sorted so lookups come back in list order.
+  std::pmr::vector<std::size_t>& offsets =
+      entry_for(books_by_author_, book.author());
+  offsets.insert(
+      std::lower_bound(offsets.begin(), offsets.end(), offset_from_top),
+      offset_from_top);
+
+  // Keep the titles sorted for prefix lookups.
+  const std::string_view title = book.title();
+  sorted_titles_.emplace(
+      std::lower_bound(sorted_titles_.begin(), sorted_titles_.end(), title),
+      title);
+
+  prices_.insert(prices_.begin() + offset_from_top, book.price());
+
+  // The new id is larger than any in use, so it goes at the end of each of
+  // the book's words' posting lists. No other posting list changes.
+  const std::size_t id = next_book_id_++;
+  book_ids_.insert(book_ids_.begin() + offset_from_top, id);
+  for (const std::string& word : words_of(book)) {
+    std::pmr::string& postings = entry_for(postings_by_word_, word);
+    std::vector<std::size_t> ids = decode_postings(postings);
+    ids.push_back(id);
+    encode_postings(ids, postings);
+  }
+
+  for (auto& view : sorted_views_) {
+    view.insert(&book);
+  }
+}
+
+void BookList::index_remove(const Book& book, std::size_t offset_from_top) {
+  // Drop the book from its author's entry, and the entry itself once empty.
+  auto entry = books_by_author_.find(std::string_view(book.author()));
+  if (entry != books_by_author_.end()) {
+    std::pmr::vector<std::size_t>& offsets = entry->second;
+    offsets.erase(
+        std::lower_bound(offsets.begin(), offsets.end(), offset_from_top));
+    if (offsets.empty()) {
+      books_by_author_.erase(entry);
+    }
+  }
+
+  // Every book below the removal point moves up one place.
+  for (auto& [author, offsets] : books_by_author_) {
+    for (std::size_t& offset : offsets) {
+      if (offset > offset_from_top) {
+        --offset;
+      }
+    }
+  }
+
+  // Drop one copy of the title; other books may share it.
+  const std::string_view title = book.title();
+  auto position = std::lower_bound(sorted_titles_.begin(),
+                                   sorted_titles_.end(), title);
+  if (position != sorted_titles_.end() && *position == title) {
+    sorted_titles_.erase(position);
+  }
+
+  prices_.erase(prices_.begin() + offset_from_top);
+
+  // Drop the book's id from each of its words' posting lists only.
+  const std::size_t id = book_ids_[offset_from_top];
+  book_ids_.erase(book_ids_.begin() + offset_from_top);
+  for (const std::string& word : words_of(book)) {
+    auto entry = postings_by_word_.find(std::string_view(word));
+    if (entry == postings_by_word_.end()) {
+      continue;
+    }
+    std::vector<std::size_t> ids = decode_postings(entry->second);
+    ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+    if (ids.empty()) {
+      postings_by_word_.erase(entry);
+    } else {
+      encode_postings(ids, entry->second);
+    }
+  }
+
+  // The views order by value, so any equal book finds the entry.
+  for (auto& view : sorted_views_) {
+    view.erase(&book);
+  }
+}
+
 //
 // Constructors, Assignments, and Destructor
 //
 
 BookList::BookList() = default;
 
-BookList::BookList(const BookList& other) = default;
+BookList::BookList(std::pmr::memory_resource* resource)
+    : books_vector_(resource),
+      node_pool_(
+          std::make_unique<std::pmr::unsynchronized_pool_resource>(resource)),
+      books_sl_list_(node_pool_.get()),
+      books_dl_list_(node_pool_.get()) {}
+
+BookList::BookList(const BookList& other)
+    : books_array_size_(other.books_array_size_),
+      books_array_(other.books_array_),
+      books_vector_(other.books_vector_),
+      books_sl_list_(other.books_sl_list_, node_pool_.get()),
+      books_dl_list_(other.books_dl_list_, node_pool_.get()),
+      books_by_author_(other.books_by_author_, node_pool_.get()),
+      sorted_titles_(other.sorted_titles_, node_pool_.get()),
+      prices_(other.prices_, node_pool_.get()),
+      postings_by_word_(other.postings_by_word_, node_pool_.get()),
+      book_ids_(other.book_ids_, node_pool_.get()),
+      next_book_id_(other.next_book_id_),
+      version_(other.version_) {
+  // The other list's views point at its own books, so build fresh ones.
+  rebuild_sorted_views();
+}
 
-BookList::BookList(BookList&& other) = default;
+BookList::BookList(BookList&& other)
+    : books_array_size_(other.books_array_size_),
+      books_array_(std::move(other.books_array_)),
+      books_vector_(std::move(other.books_vector_)),
+      node_pool_(std::move(other.node_pool_)),
+      books_sl_list_(std::move(other.books_sl_list_)),
+      books_dl_list_(std::move(other.books_dl_list_)),
+      books_by_author_(std::move(other.books_by_author_)),
+      sorted_titles_(std::move(other.sorted_titles_)),
+      prices_(std::move(other.prices_)),
+      postings_by_word_(std::move(other.postings_by_word_)),
+      book_ids_(std::move(other.book_ids_)),
+      next_book_id_(other.next_book_id_),
+      sorted_views_(std::move(other.sorted_views_)),
+      version_(other.version_) {
+  // Leave the other list empty and consistent, with a pool and indexes of its
+  // own taken from a fresh list, so the two lists share nothing and may be
+  // used from different threads.
+  other.books_array_size_ = 0;
+  BookList fresh(node_pool_->upstream_resource());
+  other.node_pool_.swap(fresh.node_pool_);
+  swap_with_allocators(other.books_sl_list_, fresh.books_sl_list_);
+  swap_with_allocators(other.books_dl_list_, fresh.books_dl_list_);
+  other.swap_indexes(fresh);
+  ++other.version_;
+}
 
-BookList& BookList::operator=(const BookList& rhs) = default;
+BookList& BookList::operator=(const BookList& rhs) {
+  BookList copy(rhs);
+  swap(copy);
+  return *this;
+}
 
-BookList& BookList::operator=(BookList&& rhs) = default;
+BookList& BookList::operator=(BookList&& rhs) {
+  BookList moved(std::move(rhs));
+  swap(moved);
+  return *this;
+}
 
 BookList::~BookList() = default;
 
@@ -120,6 +727,10 @@ std::size_t BookList::size() const {
   return books_vector_.size();
 }
 
+std::pmr::memory_resource* BookList::resource() const {
+  return books_vector_.get_allocator().resource();
+}
+
 std::size_t BookList::find(const Book& book) const {
   // Verify the internal book list state is still consistent amongst the four
   // containers.
@@ -139,6 +750,243 @@ std::size_t BookList::find(const Book& book) const {
   return size(); // Book doesn't exist.
 }
 
+const Book& BookList::at(std::size_t offset_from_top) const {
+  if (offset_from_top >= size()) {
+    throw InvalidOffsetException("Offset beyond end of current list size in at");
+  }
+  return books_vector_[offset_from_top];
+}
+
+BookList::Slice BookList::slice(std::size_t offset_from_top,
+                                std::size_t count) const {
+  // Bound the slice by the vector alone; size() would check every container
+  // first, and the slice is taken from the vector.
+  const std::size_t book_count = books_vector_.size();
+  if (offset_from_top > book_count) {
+    throw InvalidOffsetException(
+        "Offset beyond end of current list size in slice");
+  }
+  count = std::min(count, book_count - offset_from_top);
+  return {std::span<const Book>(books_vector_).subspan(offset_from_top, count),
+          version_};
+}
+
+std::uint64_t BookList::version() const {
+  return version_;
+}
+
+std::vector<std::size_t> BookList::find_by_author(
+    const std::string& author) const {
+  // Look up the author's offsets, which the index keeps in list order.
+  auto entry = books_by_author_.find(std::string_view(author));
+  if (entry == books_by_author_.end()) {
+    return {};
+  }
+  return {entry->second.begin(), entry->second.end()};
+}
+
+std::vector<std::string> BookList::titles_with_prefix(
+    const std::string& prefix, std::size_t limit) const {
+  // Titles sharing a prefix are adjacent in sorted order, starting at the
+  // first title not less than the prefix.
+  std::vector<std::string> titles;
+  for (auto title = std::lower_bound(sorted_titles_.begin(),
+                                     sorted_titles_.end(),
+                                     std::string_view(prefix));
+       title != sorted_titles_.end() && titles.size() < limit
+           && title->compare(0, prefix.size(), prefix) == 0;
+       ++title) {
+    titles.emplace_back(*title);
+  }
+  return titles;
+}
+
+std::size_t BookList::title_index_bytes() const {
+  // Count the array of string objects plus any title too long for the
+  // small-string buffer.
+  const std::size_t inline_capacity = std::pmr::string().capacity();
+  std::size_t bytes = sorted_titles_.capacity() * sizeof(std::pmr::string);
+  for (const std::pmr::string& title : sorted_titles_) {
+    if (title.capacity() > inline_capacity) {
+      bytes += title.capacity() + 1;
+    }
+  }
+  return bytes;
+}
+
+BookList::SortedView BookList::sorted_view(SortKey key) const {
+  return SortedView(sorted_views_[static_cast<std::size_t>(key)]);
+}
+
+std::size_t BookList::count_in_range(double lo, double hi) const {
+  // An empty book priced at lo sorts before every real book priced at lo, so
+  // the matching books start at its lower bound in the price view.
+  const auto& by_price = books_by_price();
+  const Book lowest({}, {}, {}, lo);
+  std::size_t count = 0;
+  for (auto book = by_price.lower_bound(&lowest);
+       book != by_price.end() && (*book)->price() <= hi; ++book) {
+    ++count;
+  }
+  return count;
+}
+
+std::vector<Book> BookList::books_in_range(double lo, double hi) const {
+  const auto& by_price = books_by_price();
+  const Book lowest({}, {}, {}, lo);
+  std::vector<Book> books;
+  for (auto book = by_price.lower_bound(&lowest);
+       book != by_price.end() && (*book)->price() <= hi; ++book) {
+    books.push_back(**book);
+  }
+  return books;
+}
+
+std::vector<Book> BookList::k_cheapest(std::size_t k) const {
+  const auto& by_price = books_by_price();
+  std::vector<Book> books;
+  for (auto book = by_price.begin();
+       book != by_price.end() && books.size() < k; ++book) {
+    books.push_back(**book);
+  }
+  return books;
+}
+
+std::vector<Book> BookList::k_most_expensive(std::size_t k) const {
+  const auto& by_price = books_by_price();
+  std::vector<Book> books;
+  for (auto book = by_price.rbegin();
+       book != by_price.rend() && books.size() < k; ++book) {
+    books.push_back(**book);
+  }
+  return books;
+}
+
+double BookList::total_price() const {
+  return ::sum_prices(prices_);
+}
+
+double BookList::mean_price() const {
+  return prices_.empty() ? 0.0 : total_price() / prices_.size();
+}
+
+double BookList::min_price() const {
+  return ::min_price(prices_);
+}
+
+double BookList::max_price() const {
+  return ::max_price(prices_);
+}
+
+std::vector<std::size_t> BookList::price_histogram(double lo, double hi,
+                                                   std::size_t buckets) const {
+  return ::price_histogram(prices_, lo, hi, buckets);
+}
+
+std::vector<std::size_t> BookList::search(const std::string& query,
+                                          Match match) const {
+  std::vector<std::string> words;
+  append_words(query, words);
+  if (words.empty()) {
+    return {};
+  }
+
+  // Merge the posting lists, which hold ascending book ids.
+  std::vector<std::size_t> hits;
+  bool first = true;
+  for (const std::string& word : words) {
+    auto entry = postings_by_word_.find(std::string_view(word));
+    if (entry == postings_by_word_.end()) {
+      if (match == Match::ALL) {
+        return {};
+      }
+      continue;
+    }
+
+    const std::vector<std::size_t> ids = decode_postings(entry->second);
+    if (first) {
+      hits = ids;
+      first = false;
+      continue;
+    }
+
+    std::vector<std::size_t> merged;
+    if (match == Match::ALL) {
+      std::set_intersection(hits.begin(), hits.end(), ids.begin(), ids.end(),
+                            std::back_inserter(merged));
+    } else {
+      std::set_union(hits.begin(), hits.end(), ids.begin(), ids.end(),
+                     std::back_inserter(merged));
+    }
+    hits = std::move(merged);
+  }
+
+  // Translate the ids to offsets in one pass over the list's ids, which also
+  // puts them in list order.
+  std::vector<std::size_t> offsets;
+  offsets.reserve(hits.size());
+  for (std::size_t offset = 0;
+       offset < book_ids_.size() && offsets.size() < hits.size(); ++offset) {
+    if (std::binary_search(hits.begin(), hits.end(), book_ids_[offset])) {
+      offsets.push_back(offset);
+    }
+  }
+  return offsets;
+}
+
+std::vector<std::size_t> BookList::fuzzy_find(const std::string& title,
+                                              std::size_t max_edits,
+                                              std::size_t limit) const {
+  // The pattern's masks and the row buffer serve every title.
+  const std::array<std::uint64_t, 256> peq = pattern_masks(title);
+  std::vector<std::size_t> row;
+  std::vector<std::size_t> hits;
+  for (std::size_t i = 0; i < books_vector_.size() && hits.size() < limit;
+       ++i) {
+    if (within_edits(title, peq, books_vector_[i].title(), max_edits, row)) {
+      hits.push_back(i);
+    }
+  }
+  return hits;
+}
+
+//
+// Iteration
+//
+
+BookList::const_iterator BookList::begin() const {
+  return books_vector_.cbegin();
+}
+
+BookList::const_iterator BookList::end() const {
+  return books_vector_.cend();
+}
+
+BookList::const_iterator BookList::cbegin() const {
+  return begin();
+}
+
+BookList::const_iterator BookList::cend() const {
+  return end();
+}
+
+BookList::const_reverse_iterator BookList::rbegin() const {
+  return books_vector_.crbegin();
+}
+
+BookList::const_reverse_iterator BookList::rend() const {
+  return books_vector_.crend();
+}
+
+bool BookList::empty() const {
+  return books_vector_.empty();
+}
+
+std::ranges::subrange<BookList::const_list_iterator> BookList::list_view()
+    const {
+  return {books_dl_list_.cbegin(), books_dl_list_.cend()};
+}
+
 //
 // Mutators
 //
@@ -179,14 +1027,26 @@ BookList& BookList::insert(const Book& book, std::size_t offset_from_top) {
     return *this;
   }
 
+  insert_unchecked(book, offset_from_top);
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in insert");
+  }
+  return *this;
+}
+
+void BookList::insert_unchecked(const Book& book, std::size_t offset_from_top) {
   // Inserting into the book list means you insert the book into each of the
   // containers (array, vector, forward_list, and list).
   //
   // Because the data structure concept is different for each container, the
   // way a book gets inserted is a little different for each. You are to insert
   // the book into each container such that the ordering of all the containers
-  // is the same. A check is made at the end of this function to verify the
-  // contents of all four containers are indeed the same.
+  // is the same. Callers check afterwards that the contents of all four
+  // containers are indeed the same.
 
   //
   // Insert into array
@@ -213,7 +1073,7 @@ BookList& BookList::insert(const Book& book, std::size_t offset_from_top) {
 
   {
     // Create vector iterator.
-    std::vector<Book>::iterator iter = books_vector_.begin();
+    std::pmr::vector<Book>::iterator iter = books_vector_.begin();
     // Advance the iterator to the offset.
     std::advance(iter, offset_from_top);
     // Insert the book at the zero-based offset.
@@ -226,7 +1086,7 @@ BookList& BookList::insert(const Book& book, std::size_t offset_from_top) {
 
   {
     // Create a forward_list iterator.
-    std::forward_list<Book>::iterator iter = books_sl_list_.before_begin();
+    std::pmr::forward_list<Book>::iterator iter = books_sl_list_.before_begin();
     // Advance the iterator to the offset.
     std::advance(iter, offset_from_top);
     // Insert the book at the zero-based offset.
@@ -239,20 +1099,42 @@ BookList& BookList::insert(const Book& book, std::size_t offset_from_top) {
 
   {
     // Create a list iterator.
-    std::list<Book>::iterator iter = books_dl_list_.begin();
+    std::pmr::list<Book>::iterator iter = books_dl_list_.begin();
     // Advance the iterator to the offset.
     std::advance(iter, offset_from_top);
-    // Insert the book at the offset.
-    books_dl_list_.insert(iter, book);
+    // Insert the book at the offset, indexing the list's own copy.
+    index_insert(*books_dl_list_.insert(iter, book), offset_from_top);
   }
 
-  // Verify the internal book list state is still consistent amongst the four
-  // containers.
-  if (!containers_are_consistent()) {
-    throw BookList::InvalidInternalStateException(
-        "Container consistency error in insert");
+  record_change(Change::Kind::INSERTED, offset_from_top, 0, &book);
+}
+
+void BookList::append_unchecked(std::span<const Book> books) {
+  if (books.empty()) {
+    return;
+  }
+  if (books.size() > books_array_.size() - books_array_size_) {
+    throw CapacityExceededException("Capacity Exceeded");
+  }
+
+  // Each container takes the whole batch at its end. The singly-linked list
+  // is walked once to find its last node.
+  const std::size_t first_offset = books_vector_.size();
+  std::copy(books.begin(), books.end(),
+            books_array_.begin() + books_array_size_);
+  books_array_size_ += books.size();
+  books_vector_.insert(books_vector_.end(), books.begin(), books.end());
+  books_sl_list_.insert_after(
+      std::next(books_sl_list_.before_begin(), first_offset), books.begin(),
+      books.end());
+  books_dl_list_.insert(books_dl_list_.end(), books.begin(), books.end());
+
+  // Build the indexes once rather than shifting them for every book.
+  rebuild_indexes();
+
+  for (std::size_t i = 0; i < books.size(); ++i) {
+    record_change(Change::Kind::INSERTED, first_offset + i, 0, &books[i]);
   }
-  return *this;
 }
 
 BookList& BookList::remove(const Book& book) {
@@ -275,6 +1157,10 @@ BookList& BookList::remove(std::size_t offset_from_top) {
     return *this;
   }
 
+  // Update the secondary indexes while the book is still in place.
+  index_remove(books_vector_[offset_from_top], offset_from_top);
+  record_change(Change::Kind::REMOVED, offset_from_top);
+
   //
   // Remove from array
   //
@@ -293,7 +1179,7 @@ BookList& BookList::remove(std::size_t offset_from_top) {
 
   {
     // Create a vector iterator.
-    std::vector<Book>::iterator iter = books_vector_.begin();
+    std::pmr::vector<Book>::iterator iter = books_vector_.begin();
     // Advance the iterator to the offset.
     std::advance(iter, offset_from_top);
     // Erase the iterator at the offset.
@@ -306,7 +1192,7 @@ BookList& BookList::remove(std::size_t offset_from_top) {
 
   {
     // Create a forward_list iterator.
-    std::forward_list<Book>::iterator iter = books_sl_list_.before_begin();
+    std::pmr::forward_list<Book>::iterator iter = books_sl_list_.before_begin();
     // Advance the iterator to 1 before the offset.
     std::advance(iter, offset_from_top);
     // Erase the iterator at the offset.
@@ -319,7 +1205,7 @@ BookList& BookList::remove(std::size_t offset_from_top) {
 
   {
     // Create a list iterator.
-    std::list<Book>::iterator iter = books_dl_list_.begin();
+    std::pmr::list<Book>::iterator iter = books_dl_list_.begin();
     // Advance the iterator to the offset.
     std::advance(iter, offset_from_top);
     // Erase the iterator at the offset.
@@ -335,33 +1221,504 @@ BookList& BookList::remove(std::size_t offset_from_top) {
   return *this;
 }
 
+std::size_t BookList::remove_if(
+    const std::function<bool(const Book&)>& predicate) {
+  // Decide each book once, so every container removes the same books.
+  std::vector<bool> doomed;
+  doomed.reserve(size());
+  std::size_t removed = 0;
+  for (const Book& book : books_vector_) {
+    doomed.push_back(predicate(book));
+    if (doomed.back()) {
+      ++removed;
+    }
+  }
+  if (removed == 0) {
+    return 0;
+  }
+
+  // Report each removal at the offset it has once the earlier ones are done.
+  for (std::size_t i = 0, gone = 0; i < doomed.size(); ++i) {
+    if (doomed[i]) {
+      record_change(Change::Kind::REMOVED, i - gone++);
+    }
+  }
+
+  // The sorted views point at nodes about to be freed.
+  for (auto& view : sorted_views_) {
+    view.clear();
+  }
+
+  //
+  // Remove from array
+  //
+
+  {
+    // Slide each kept book down over the gaps left by removed ones.
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < books_array_size_; ++i) {
+      if (!doomed[i]) {
+        if (kept != i) {
+          books_array_[kept] = std::move(books_array_[i]);
+        }
+        ++kept;
+      }
+    }
+    std::fill(books_array_.begin() + kept,
+              books_array_.begin() + books_array_size_, Book());
+    books_array_size_ = kept;
+  }
+
+  //
+  // Remove from vector
+  //
+
+  {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < books_vector_.size(); ++i) {
+      if (!doomed[i]) {
+        if (kept != i) {
+          books_vector_[kept] = std::move(books_vector_[i]);
+        }
+        ++kept;
+      }
+    }
+    books_vector_.erase(books_vector_.begin() + kept, books_vector_.end());
+  }
+
+  //
+  // Remove from singly-linked list
+  //
+
+  {
+    auto before = books_sl_list_.before_begin();
+    for (bool remove : doomed) {
+      if (remove) {
+        books_sl_list_.erase_after(before);
+      } else {
+        ++before;
+      }
+    }
+  }
+
+  //
+  // Remove from doubly-linked list
+  //
+
+  {
+    auto iter = books_dl_list_.begin();
+    for (bool remove : doomed) {
+      iter = remove ? books_dl_list_.erase(iter) : std::next(iter);
+    }
+  }
+
+  // Offsets have shifted throughout, so rebuild the indexes in one pass.
+  rebuild_indexes();
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in remove_if");
+  }
+  return removed;
+}
+
 BookList& BookList::move_to_top(const Book& book) {
   // If the book exists, it moves to the top of the list.
-  if (find(book) != size()) {
-    remove(book); // Remove book.
-    insert(book, 0); // Reinsert the book at the top.
+  const std::size_t offset_from_top = find(book);
+  if (offset_from_top != size()) {
+    move(offset_from_top, 0);
   }
+  return *this;
+}
+
+BookList& BookList::move(std::size_t from_offset, std::size_t to_offset) {
+  if (from_offset >= size() || to_offset >= size()) {
+    throw InvalidOffsetException(
+        "Offset beyond end of current list size in move");
+  }
+  if (from_offset == to_offset) {
+    return *this;
+  }
+
+  // Moving a book down rotates it past the books below it, and moving it up
+  // rotates the books above it past it. Either way only the books between
+  // the two offsets shift.
+  const bool down = from_offset < to_offset;
+  const std::size_t first = down ? from_offset : to_offset;
+  const std::size_t middle = down ? from_offset + 1 : from_offset;
+  const std::size_t last = (down ? to_offset : from_offset) + 1;
+
+  //
+  // Move within array
+  //
+
+  std::rotate(books_array_.begin() + first, books_array_.begin() + middle,
+              books_array_.begin() + last);
+
+  //
+  // Move within vector
+  //
+
+  std::rotate(books_vector_.begin() + first, books_vector_.begin() + middle,
+              books_vector_.begin() + last);
+
+  //
+  // Move within singly-linked list
+  //
+
+  {
+    // Relink the node after the one before it, to follow the node that will
+    // precede it.
+    auto before_from = std::next(books_sl_list_.before_begin(), from_offset);
+    auto before_to =
+        std::next(books_sl_list_.before_begin(), down ? to_offset + 1
+                                                       : to_offset);
+    books_sl_list_.splice_after(before_to, books_sl_list_, before_from);
+  }
+
+  //
+  // Move within doubly-linked list
+  //
+
+  {
+    auto from = std::next(books_dl_list_.begin(), from_offset);
+    auto to = std::next(books_dl_list_.begin(),
+                        down ? to_offset + 1 : to_offset);
+    books_dl_list_.splice(to, books_dl_list_, from);
+  }
+
+  // The nodes are the same, so the sorted views still hold; only the
+  // offsets have changed. The book ids move with their books.
+  std::rotate(book_ids_.begin() + first, book_ids_.begin() + middle,
+              book_ids_.begin() + last);
+  reindex_offsets();
+  record_change(Change::Kind::MOVED, from_offset, to_offset);
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in move");
+  }
+  return *this;
+}
+
+BookList& BookList::rotate(std::size_t middle) {
+  const std::size_t count = size();
+  if (middle > count) {
+    throw InvalidOffsetException(
+        "Offset beyond end of current list size in rotate");
+  }
+  if (middle == 0 || middle == count) {
+    return *this;
+  }
+
+  std::rotate(books_array_.begin(), books_array_.begin() + middle,
+              books_array_.begin() + books_array_size_);
+  std::rotate(books_vector_.begin(), books_vector_.begin() + middle,
+              books_vector_.end());
+
+  // Relink the books above middle after the last book.
+  {
+    auto before_middle = std::next(books_sl_list_.before_begin(), middle);
+    auto last = std::next(before_middle, count - middle);
+    books_sl_list_.splice_after(last, books_sl_list_,
+                                books_sl_list_.before_begin(),
+                                std::next(before_middle));
+  }
+  books_dl_list_.splice(books_dl_list_.end(), books_dl_list_,
+                        books_dl_list_.begin(),
+                        std::next(books_dl_list_.begin(), middle));
+
+  std::vector<std::size_t> order(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    order[i] = (i + middle) % count;
+  }
+  std::rotate(book_ids_.begin(), book_ids_.begin() + middle, book_ids_.end());
+  reindex_offsets();
+  record_reorder(order);
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in rotate");
+  }
+  return *this;
+}
+
+BookList& BookList::reverse() {
+  if (size() < 2) {
+    return *this;
+  }
+
+  std::reverse(books_array_.begin(), books_array_.begin() + books_array_size_);
+  std::reverse(books_vector_.begin(), books_vector_.end());
+  books_sl_list_.reverse();
+  books_dl_list_.reverse();
+
+  std::vector<std::size_t> order(size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    order[i] = order.size() - 1 - i;
+  }
+  std::reverse(book_ids_.begin(), book_ids_.end());
+  reindex_offsets();
+  record_reorder(order);
 
   // Verify the internal book list state is still consistent amongst the four
   // containers.
   if (!containers_are_consistent()) {
     throw BookList::InvalidInternalStateException(
-        "Container consistency error in move_to_top");
+        "Container consistency error in reverse");
   }
   return *this;
 }
 
-void BookList::swap(BookList& rhs) noexcept {
+BookList& BookList::sort(SortKey key) {
+  auto less = [key](const Book& lhs, const Book& rhs) {
+    return key_less(key, lhs, rhs);
+  };
+
+  // Work out where each book goes first, for the change feed.
+  std::vector<std::size_t> order(size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t lhs, std::size_t rhs) {
+                     return less(books_vector_[lhs], books_vector_[rhs]);
+                   });
+  if (std::is_sorted(order.begin(), order.end())) {
+    return *this;
+  }
+
+  // Every container sorts stably with the same ordering, so all four end up
+  // in the same order. The linked lists relink their nodes rather than copy
+  // books.
+  std::stable_sort(books_array_.begin(),
+                   books_array_.begin() + books_array_size_, less);
+  std::stable_sort(books_vector_.begin(), books_vector_.end(), less);
+  books_sl_list_.sort(less);
+  books_dl_list_.sort(less);
+
+  // Each book's id follows it to its new offset.
+  std::pmr::vector<std::size_t> ids(book_ids_.get_allocator());
+  ids.reserve(order.size());
+  for (std::size_t old_offset : order) {
+    ids.push_back(book_ids_[old_offset]);
+  }
+  book_ids_.swap(ids);
+  reindex_offsets();
+  record_reorder(order);
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in sort");
+  }
+  return *this;
+}
+
+void BookList::swap(BookList& rhs) {
   if (this == &rhs) {
     return;
   }
 
+  // Do everything that allocates first, so that if any of it throws neither
+  // list has changed. The exchange that follows cannot throw.
+
+  // Each side's subscribers see its old contents replaced by the other's.
+  std::vector<Change> pending = pending_with_reset(rhs.books_vector_);
+  std::vector<Change> rhs_pending = rhs.pending_with_reset(books_vector_);
+
+  // Containers may only trade storage when they share a memory resource.
+  // Otherwise each side's books and indexes are first copied into the other's
+  // resource, with sorted views over the copied books, since the old nodes
+  // are about to go.
+  const bool same_resource = resource() == rhs.resource();
+  if (!same_resource) {
+    std::pmr::vector<Book> vector(rhs.books_vector_, resource());
+    std::pmr::forward_list<Book> sl_list(rhs.books_sl_list_,
+                                         node_pool_.get());
+    std::pmr::list<Book> dl_list(rhs.books_dl_list_, node_pool_.get());
+    std::pmr::vector<Book> rhs_vector(books_vector_, rhs.resource());
+    std::pmr::forward_list<Book> rhs_sl_list(books_sl_list_,
+                                             rhs.node_pool_.get());
+    std::pmr::list<Book> rhs_dl_list(books_dl_list_, rhs.node_pool_.get());
+    std::pmr::memory_resource* pool = node_pool_.get();
+    std::pmr::memory_resource* rhs_pool = rhs.node_pool_.get();
+    auto views = sorted_views_over(dl_list, pool);
+    auto rhs_views = sorted_views_over(rhs_dl_list, rhs_pool);
+    auto by_author = copy_into(rhs.books_by_author_, pool);
+    auto titles = copy_into(rhs.sorted_titles_, pool);
+    auto prices = copy_into(rhs.prices_, pool);
+    auto postings = copy_into(rhs.postings_by_word_, pool);
+    auto ids = copy_into(rhs.book_ids_, pool);
+    auto rhs_by_author = copy_into(books_by_author_, rhs_pool);
+    auto rhs_titles = copy_into(sorted_titles_, rhs_pool);
+    auto rhs_prices = copy_into(prices_, rhs_pool);
+    auto rhs_postings = copy_into(postings_by_word_, rhs_pool);
+    auto rhs_ids = copy_into(book_ids_, rhs_pool);
+
+    // Each copy already uses its destination's allocator, so these swaps
+    // exchange pointers only.
+    books_vector_.swap(vector);
+    books_sl_list_.swap(sl_list);
+    books_dl_list_.swap(dl_list);
+    rhs.books_vector_.swap(rhs_vector);
+    rhs.books_sl_list_.swap(rhs_sl_list);
+    rhs.books_dl_list_.swap(rhs_dl_list);
+    sorted_views_.swap(views);
+    rhs.sorted_views_.swap(rhs_views);
+    books_by_author_.swap(by_author);
+    sorted_titles_.swap(titles);
+    prices_.swap(prices);
+    postings_by_word_.swap(postings);
+    book_ids_.swap(ids);
+    rhs.books_by_author_.swap(rhs_by_author);
+    rhs.sorted_titles_.swap(rhs_titles);
+    rhs.prices_.swap(rhs_prices);
+    rhs.postings_by_word_.swap(rhs_postings);
+    rhs.book_ids_.swap(rhs_ids);
+  } else {
+    books_vector_.swap(rhs.books_vector_);
+
+    // Node pools over the same resource are interchangeable, so the linked
+    // lists and indexes trade pools along with their contents.
+    swap_with_allocators(books_dl_list_, rhs.books_dl_list_);
+    swap_with_allocators(books_sl_list_, rhs.books_sl_list_);
+    node_pool_.swap(rhs.node_pool_);
+    swap_indexes(rhs);
+  }
+
+  change_feed_.pending.swap(pending);
+  rhs.change_feed_.pending.swap(rhs_pending);
+  ++version_;
+  ++rhs.version_;
+
   books_array_.swap(rhs.books_array_);
-  books_vector_.swap(rhs.books_vector_);
-  books_dl_list_.swap(rhs.books_dl_list_);
-  books_sl_list_.swap(rhs.books_sl_list_);
 
   std::swap(books_array_size_, rhs.books_array_size_);
+  std::swap(next_book_id_, rhs.next_book_id_);
+}
+
+//
+// Merging
+//
+
+BookList BookList::merge(std::span<const BookList* const> book_lists,
+                         MergePolicy policy) {
+  BookList merged;
+  std::unordered_set<Book> seen;
+  std::vector<Book> books;
+
+  // Keeps book unless an earlier list already supplied it. The seen set
+  // replaces the linear find() that insert() would do.
+  auto append = [&](const Book& book) {
+    if (seen.insert(book).second) {
+      books.push_back(book);
+    }
+  };
+
+  switch (policy) {
+    case MergePolicy::CONCATENATE: {
+      for (const BookList* book_list : book_lists) {
+        for (const Book& book : book_list->books_vector_) {
+          append(book);
+        }
+      }
+      break;
+    }
+    case MergePolicy::ROUND_ROBIN: {
+      for (std::size_t i = 0;; ++i) {
+        bool any_left = false;
+        for (const BookList* book_list : book_lists) {
+          if (i < book_list->books_vector_.size()) {
+            append(book_list->books_vector_[i]);
+            any_left = true;
+          }
+        }
+        if (!any_left) {
+          break;
+        }
+      }
+      break;
+    }
+  }
+  merged.append_unchecked(books);
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!merged.containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in merge");
+  }
+  return merged;
+}
+
+std::size_t BookList::append_unique(const std::function<bool(Book&)>& next) {
+  std::unordered_set<Book> seen(books_vector_.begin(), books_vector_.end());
+  std::vector<Book> books;
+  Book book;
+  std::size_t count = 0;
+  while (next(book)) {
+    if (seen.insert(book).second) {
+      books.push_back(book);
+    }
+    ++count;
+  }
+  append_unchecked(books);
+
+  // Verify the internal book list state is still consistent amongst the four
+  // containers.
+  if (!containers_are_consistent()) {
+    throw BookList::InvalidInternalStateException(
+        "Container consistency error in append_unique");
+  }
+  return count;
+}
+
+//
+// Change Feed
+//
+
+std::size_t BookList::subscribe(Subscriber subscriber) {
+  const std::size_t id = change_feed_.next_id++;
+  change_feed_.subscribers.emplace_back(id, std::move(subscriber));
+  return id;
+}
+
+void BookList::unsubscribe(std::size_t id) {
+  auto& subscribers = change_feed_.subscribers;
+  subscribers.erase(
+      std::remove_if(subscribers.begin(), subscribers.end(),
+                     [id](const auto& entry) { return entry.first == id; }),
+      subscribers.end());
+  if (subscribers.empty()) {
+    change_feed_.pending.clear();
+  }
+}
+
+void BookList::flush_changes() {
+  if (change_feed_.pending.empty()) {
+    return;
+  }
+  // Take the batch first so subscribers may safely change the list.
+  const std::vector<Change> changes = std::move(change_feed_.pending);
+  change_feed_.pending.clear();
+
+  // Deliver from a copy of the subscribers, since a subscriber may subscribe
+  // or unsubscribe from its callback. Those unsubscribed along the way are
+  // skipped; those subscribed along the way wait for the next batch.
+  const auto subscribers = change_feed_.subscribers;
+  for (const auto& [id, subscriber] : subscribers) {
+    const auto& current = change_feed_.subscribers;
+    if (std::any_of(current.begin(), current.end(),
+                    [id](const auto& entry) { return entry.first == id; })) {
+      subscriber(changes);
+    }
+  }
 }
 
 //
@@ -388,26 +1745,70 @@ std::istream& operator>>(std::istream& stream, BookList& book_list) {
     throw BookList::InvalidInternalStateException(
         "Container consistency error in operator>>");
   }
+  book_list.read(stream, BookList::IsbnPolicy::KEEP);
+  return stream;
+}
+
+std::size_t BookList::read(std::istream& stream, IsbnPolicy policy) {
   std::string label_holder;
-  size_t count;
-  
-  // Read from the stream.
-  BookList temp_list; // Create a temporary book list.
+  size_t count = 0;
+
+  // Read from the stream, staging the books on the list's memory resource.
+  // Only books actually read are staged, so a corrupt or truncated count
+  // cannot decide how much is allocated.
+  std::pmr::vector<Book> books(resource());
   stream >> count; // Read in the size of the list.
-  for (int i = 0; i < count; ++i) { // Iterates for every book in the list.
+  for (std::size_t i = 0; i < count && stream; ++i) {
     // Create a temporary book.
     Book temp;
     // Read in the ":  ".
     stream >> label_holder;
     // Read in the book from the book list.
     stream >> temp;
+    if (!stream) {
+      break;
+    }
+    books.push_back(std::move(temp));
+  }
+
+  // Normalise the ISBNs as one batch, which empties the invalid ones.
+  std::vector<std::string> isbns;
+  std::size_t rejected = 0;
+  if (policy != IsbnPolicy::KEEP) {
+    isbns.reserve(books.size());
+    for (const Book& book : books) {
+      isbns.push_back(book.isbn());
+    }
+    normalize_isbns(isbns);
+  }
+
+  // Create a temporary book list drawing on the same memory resource.
+  BookList temp_list(resource());
+  for (std::size_t i = 0; i < books.size(); ++i) {
+    if (policy != IsbnPolicy::KEEP) {
+      if (!isbns[i].empty()) {
+        books[i].isbn(isbns[i]);
+      } else if (policy == IsbnPolicy::REJECT_INVALID) {
+        ++rejected;
+        continue;
+      }
+    }
     //Insert the book to the bottom of our temporary list.
-    temp_list.insert(temp, BookList::Position::BOTTOM);
+    temp_list.insert(books[i], BookList::Position::BOTTOM);
   }
-  // Modify book_list.
-  book_list = std::move(temp_list);
-  
-  return stream;
+  // Modify this book list.
+  *this = std::move(temp_list);
+
+  return rejected;
+}
+
+//
+// Removal
+//
+
+std::size_t erase_if(BookList& book_list,
+                     const std::function<bool(const Book&)>& predicate) {
+  return book_list.remove_if(predicate);
 }
 
 //
@@ -3,11 +3,22 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <forward_list>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <set>
+#include <span>
 #include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "book.hpp"
@@ -29,6 +40,107 @@ class BookList {
 
   enum class Position {TOP, BOTTOM};
 
+  // Whether a search must match all of its terms or any one of them.
+  enum class Match {ALL, ANY};
+
+  // How read() treats the ISBNs of the books it loads: leave them as they
+  // are, normalise the valid ones to ISBN-13, or also drop books whose ISBN
+  // is invalid.
+  enum class IsbnPolicy {KEEP, NORMALIZE, REJECT_INVALID};
+
+  // The order in which merge() takes books from its lists: each list in turn,
+  // as chained operator+= would, or one book from each list at a time.
+  enum class MergePolicy {CONCATENATE, ROUND_ROBIN};
+
+  // A change to the book list, as reported to subscribers.
+  struct Change {
+    enum class Kind {INSERTED, REMOVED, MOVED};
+
+    Kind kind;
+
+    // The offset the book was inserted at, removed from, or moved from.
+    std::size_t offset;
+
+    // The offset a moved book now occupies.
+    std::size_t to;
+
+    // The inserted book. Empty for other kinds.
+    Book book;
+  };
+
+  // Receives one batch of changes, oldest first. Replaying them in order on a
+  // copy of the list as it stood at the previous batch reproduces the list.
+  using Subscriber = std::function<void(const std::vector<Change>& changes)>;
+
+  // The fields a sorted view can order books by.
+  enum class SortKey {TITLE, AUTHOR, ISBN, PRICE};
+
+  // Orders books by one sort key, breaking ties with the book's own ordering.
+  struct KeyOrder {
+    SortKey key;
+    bool operator()(const Book* lhs, const Book* rhs) const noexcept;
+  };
+
+  // A live, read-only view of the book list sorted by one key.
+  //
+  // The view refers to books held by the list rather than copies, reflects
+  // every later change to the list, and is invalidated when the list is
+  // destroyed.
+  class SortedView {
+   public:
+    // Iterates the view's books in sorted order.
+    class const_iterator {
+     public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type = Book;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const Book*;
+      using reference = const Book&;
+
+      const_iterator() = default;
+      explicit const_iterator(
+          std::pmr::set<const Book*, KeyOrder>::const_iterator position);
+
+      reference operator*() const;
+      pointer operator->() const;
+      const_iterator& operator++();
+      const_iterator operator++(int);
+      const_iterator& operator--();
+      const_iterator operator--(int);
+      bool operator==(const const_iterator& rhs) const;
+      bool operator!=(const const_iterator& rhs) const;
+
+     private:
+      std::pmr::set<const Book*, KeyOrder>::const_iterator position_;
+    };
+
+    explicit SortedView(const std::pmr::set<const Book*, KeyOrder>& books);
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    std::size_t size() const;
+
+   private:
+    const std::pmr::set<const Book*, KeyOrder>* books_;
+  };
+
+  // A page of the book list, with the version of the list it was taken from.
+  // The books are the ones the list holds, valid until the list next changes.
+  struct Slice {
+    std::span<const Book> books;
+    std::uint64_t version;
+  };
+
+  // Iterates the books top to bottom with random access, over the vector
+  // container.
+  using const_iterator = std::pmr::vector<Book>::const_iterator;
+  using const_reverse_iterator = std::pmr::vector<Book>::const_reverse_iterator;
+
+  // Iterates the books top to bottom over the doubly-linked list container,
+  // whose iterators, unlike const_iterator, stay valid across inserts and
+  // removals of other books.
+  using const_list_iterator = std::pmr::list<Book>::const_iterator;
+
   // Thrown if internal data structures become inconsistent with each other.
   struct InvalidInternalStateException : std::domain_error {
     using domain_error::domain_error;
@@ -51,6 +163,16 @@ class BookList {
   // This constructor constructs an empty book list.
   BookList();
 
+  // This constructor constructs an empty book list whose containers and
+  // indexes all allocate from resource, which must outlive the book list.
+  // The linked lists and indexes draw their memory from a pool on top of
+  // resource.
+  //
+  // Copies of the list use the default resource, as other pmr containers
+  // do. Moves keep the resource, and swapping with a list on a different
+  // resource copies the books and indexes across.
+  explicit BookList(std::pmr::memory_resource* resource);
+
   // The copy constructor constructs a book list as a copy of another book list.
   BookList(const BookList& other);
 
@@ -82,11 +204,113 @@ class BookList {
   // Returns the number of books in this book list.
   std::size_t size() const;
 
+  // Returns the memory resource the list's containers allocate from.
+  std::pmr::memory_resource* resource() const;
+
   // Returns the (zero-based) offset from the top of the list for book.
   //
   // If the book is not in the list, returns size().
   std::size_t find(const Book& book) const;
 
+  // Returns the book at the (zero-based) offset from the top of the list.
+  //
+  // Throws InvalidOffsetException if the offset is not less than size().
+  const Book& at(std::size_t offset_from_top) const;
+
+  // Returns up to count books starting at the (zero-based) offset from the
+  // top, in constant time and without copying them.
+  //
+  // Throws InvalidOffsetException if the offset is greater than size().
+  Slice slice(std::size_t offset_from_top, std::size_t count) const;
+
+  // Returns the version of the list's contents, which changes whenever a book
+  // is inserted, removed, or moved, or the list is swapped or assigned. A
+  // Slice is up to date while its version matches.
+  std::uint64_t version() const;
+
+  // Returns the offsets of every book written by author, in list order.
+  //
+  // Served from the author index, so the cost is proportional to the number of
+  // matches rather than the size of the list.
+  std::vector<std::size_t> find_by_author(const std::string& author) const;
+
+  // Returns up to limit titles starting with prefix, in lexicographic order.
+  //
+  // Served from the title index with a binary search, so the cost is
+  // logarithmic in the size of the list plus the number of titles returned.
+  std::vector<std::string> titles_with_prefix(const std::string& prefix,
+                                              std::size_t limit) const;
+
+  // Returns the approximate number of bytes held by the title index.
+  std::size_t title_index_bytes() const;
+
+  // Returns a view of the book list sorted by key.
+  SortedView sorted_view(SortKey key) const;
+
+  // Returns the number of books priced from lo to hi, inclusive.
+  std::size_t count_in_range(double lo, double hi) const;
+
+  // Returns the books priced from lo to hi, inclusive, cheapest first.
+  std::vector<Book> books_in_range(double lo, double hi) const;
+
+  // Returns the k cheapest books, cheapest first.
+  std::vector<Book> k_cheapest(std::size_t k) const;
+
+  // Returns the k most expensive books, most expensive first.
+  std::vector<Book> k_most_expensive(std::size_t k) const;
+
+  // Returns the sum of the prices of every book.
+  double total_price() const;
+
+  // Returns the average price of the books, or 0.0 if the list is empty.
+  double mean_price() const;
+
+  // Returns the lowest price in the list, or 0.0 if the list is empty.
+  double min_price() const;
+
+  // Returns the highest price in the list, or 0.0 if the list is empty.
+  double max_price() const;
+
+  // Returns the number of books in each of buckets equal-width price buckets
+  // spanning lo to hi. See ::price_histogram().
+  std::vector<std::size_t> price_histogram(double lo, double hi,
+                                           std::size_t buckets) const;
+
+  // Returns the offsets, in list order, of the books whose title or author
+  // contains all (or any) of the words in query.
+  //
+  // Words are runs of letters and digits, compared case-insensitively. The
+  // cost is the length of the query words' posting lists, plus one pass over
+  // the list's book ids to turn the hits into offsets.
+  std::vector<std::size_t> search(const std::string& query,
+                                  Match match = Match::ALL) const;
+
+  // Returns the offsets, in list order, of up to limit books whose title is
+  // within max_edits insertions, deletions, or substitutions of title.
+  std::vector<std::size_t> fuzzy_find(const std::string& title,
+                                      std::size_t max_edits,
+                                      std::size_t limit) const;
+
+  //
+  // Iteration
+  //
+  // Every iterator refers to the books held by the list, so traversal makes
+  // no copies. Any change to the list invalidates const_iterators.
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+  const_reverse_iterator rbegin() const;
+  const_reverse_iterator rend() const;
+
+  // Returns whether the book list holds no books.
+  bool empty() const;
+
+  // Returns a bidirectional view of the books, top to bottom, over the
+  // doubly-linked list container.
+  std::ranges::subrange<const_list_iterator> list_view() const;
+
   //
   // Mutators
   //
@@ -111,12 +335,90 @@ class BookList {
   // If the offset is past the size of the book list, the method does nothing.
   BookList& remove(std::size_t offset_from_top);
 
+  // Removes every book for which predicate returns true, keeping the order of
+  // the rest, and returns the number removed.
+  //
+  // The predicate is called once per book, and each container is swept once,
+  // rather than once per book removed as repeated remove() calls would.
+  std::size_t remove_if(const std::function<bool(const Book&)>& predicate);
+
   // Locates the book, removes the book from its current location, and inserts
   // the book at the top of the book list.
   BookList& move_to_top(const Book& book);
 
+  // Moves the book at from_offset so that it ends up at to_offset, shifting
+  // the books between them one place.
+  //
+  // Throws InvalidOffsetException if either offset is not less than size().
+  BookList& move(std::size_t from_offset, std::size_t to_offset);
+
+  // Rotates the book list so that the book at middle becomes the top and the
+  // books above it go to the bottom, as std::rotate does.
+  //
+  // Throws InvalidOffsetException if middle is greater than size().
+  BookList& rotate(std::size_t middle);
+
+  // Reverses the order of the book list.
+  BookList& reverse();
+
+  // Sorts the book list by key, keeping books with equal keys in their
+  // current order.
+  BookList& sort(SortKey key);
+
   // Swaps the book list with the `rhs` book list.
-  void swap(BookList& rhs) noexcept;
+  //
+  // If the swap throws, neither book list is changed.
+  void swap(BookList& rhs);
+
+  //
+  // Merging
+  //
+
+  // Returns the union of book_lists, keeping the first occurrence of each
+  // book in the order given by policy.
+  //
+  // With MergePolicy::CONCATENATE the result equals chaining operator+= over
+  // the lists, but each book costs one hash lookup instead of a linear find,
+  // and the indexes are built once at the end, so the cost is linear in the
+  // number of books plus the cost of rebuild_indexes().
+  static BookList merge(std::span<const BookList* const> book_lists,
+                        MergePolicy policy = MergePolicy::CONCATENATE);
+
+  // Appends the books produced by next to the bottom of the list, skipping
+  // books the list already holds, until next returns false. Returns the
+  // number of books produced.
+  //
+  // As in merge(), each book costs one hash lookup instead of the linear find
+  // insert() does, and the new books are appended and indexed as one batch
+  // once next is done. If they do not fit, CapacityExceededException is
+  // thrown and the list is left unchanged.
+  std::size_t append_unique(const std::function<bool(Book&)>& next);
+
+  //
+  // Change Feed
+  //
+
+  // Registers subscriber for batches of changes, returning an id for
+  // unsubscribe(). Changes are only recorded while someone is subscribed.
+  //
+  // Subscribers belong to this object rather than its value: copies and
+  // moves start without any, and assignment and swap keep them, reporting
+  // the replaced contents as removals followed by insertions.
+  std::size_t subscribe(Subscriber subscriber);
+
+  // Stops delivering changes to the subscriber with id.
+  void unsubscribe(std::size_t id);
+
+  // Delivers the changes recorded since the last flush to every subscriber
+  // as a single batch. Subscribers may change the list, subscribe, and
+  // unsubscribe from their callbacks.
+  void flush_changes();
+
+  // Replaces the book list with one read from stream in the format written
+  // by operator<<, applying policy to each book's ISBN.
+  //
+  // Returns the number of books rejected for an invalid ISBN.
+  std::size_t read(std::istream& stream, IsbnPolicy policy);
 
   //
   // Comparisons
@@ -129,6 +431,53 @@ class BookList {
   int compare(const BookList& other) const;
 
  private:
+  // The subscribers and the changes awaiting the next flush.
+  //
+  // Copying or moving yields an empty feed, and assigning leaves the target
+  // unchanged, so subscribers stay with the object they subscribed to.
+  struct ChangeFeed {
+    ChangeFeed() = default;
+    ChangeFeed(const ChangeFeed& other);
+    ChangeFeed& operator=(const ChangeFeed& rhs);
+
+    std::vector<std::pair<std::size_t, Subscriber>> subscribers;
+    std::vector<Change> pending;
+    std::size_t next_id = 0;
+  };
+
+  // Inserts book at offset_from_top into every container and index, without
+  // validating the offset, checking for duplicates, or checking consistency.
+  void insert_unchecked(const Book& book, std::size_t offset_from_top);
+
+  // Appends books to the bottom of every container, then rebuilds the
+  // indexes once, without checking for duplicates or consistency.
+  //
+  // Throws CapacityExceededException, changing nothing, if the books do not
+  // fit.
+  void append_unchecked(std::span<const Book> books);
+
+  // Advances the version and, if anyone is subscribed, records a change of
+  // kind at offset, where to is the offset a moved book goes to and book the
+  // inserted book. The change, and its copy of the book, is only built when
+  // there is a subscriber to receive it.
+  void record_change(Change::Kind kind, std::size_t offset, std::size_t to = 0,
+                     const Book* book = nullptr);
+
+  // Returns the pending changes followed by the replacement of this list's
+  // contents by new_books, whose books are in list order, if anyone is
+  // subscribed.
+  std::vector<Change> pending_with_reset(
+      const std::pmr::vector<Book>& new_books) const;
+
+  // Advances the version and records a reordering of the list as moves, where
+  // order[i] is the old offset of the book now at offset i.
+  void record_reorder(const std::vector<std::size_t>& order);
+
+  // Orders books by price, breaking ties with the book's own ordering.
+  struct PriceOrder {
+    bool operator()(const Book& lhs, const Book& rhs) const noexcept;
+  };
+
   // Returns whether the four containers are mutually consistent with
   // each other.
   bool containers_are_consistent() const;
@@ -137,6 +486,40 @@ class BookList {
   // its own size.
   std::size_t books_sl_list_size() const;
 
+  // Repopulates the sorted views from books_dl_list_.
+  void rebuild_sorted_views();
+
+  // Returns sorted views over books, allocating from resource.
+  static std::array<std::pmr::set<const Book*, KeyOrder>, 4> sorted_views_over(
+      const std::pmr::list<Book>& books, std::pmr::memory_resource* resource);
+
+  // Returns the books from cheapest to most expensive, through the PRICE
+  // sorted view.
+  const std::pmr::set<const Book*, KeyOrder>& books_by_price() const;
+
+  // Exchanges the secondary indexes and sorted views with rhs's, together
+  // with their allocators.
+  void swap_indexes(BookList& rhs);
+
+  // Repopulates every secondary index, and the sorted views, from
+  // books_dl_list_.
+  void rebuild_indexes();
+
+  // Repopulates the secondary indexes that depend on the order of the books,
+  // for changes that reorder books_dl_list_ without replacing its nodes.
+  // Callers reorder book_ids_ to match first; the full-text index is keyed by
+  // id and needs no change.
+  void reindex_offsets();
+
+  // Records the book just inserted at offset_from_top in the secondary
+  // indexes, shifting the offsets of the books below it. The book must be the
+  // copy held in books_dl_list_, whose address the sorted views keep.
+  void index_insert(const Book& book, std::size_t offset_from_top);
+
+  // Drops the book about to be removed from offset_from_top from the
+  // secondary indexes, shifting the offsets of the books below it.
+  void index_remove(const Book& book, std::size_t offset_from_top);
+
   // The number of books in books_array.
   std::size_t books_array_size_ = 0;
 
@@ -144,15 +527,74 @@ class BookList {
   std::array<Book, 11> books_array_;
 
   // The vector container.
-  std::vector<Book> books_vector_;
+  std::pmr::vector<Book> books_vector_;
+
+  // The pool the linked lists take their nodes from, and the secondary
+  // indexes their memory. Memory freed by remove() returns to the pool's free
+  // lists and is reused by the next insert(), so steady-state editing makes
+  // no calls to the underlying resource. No two lists share a pool: a move
+  // takes the pool along and gives the list moved from a fresh one.
+  std::unique_ptr<std::pmr::unsynchronized_pool_resource> node_pool_ =
+      std::make_unique<std::pmr::unsynchronized_pool_resource>();
 
   // The singly-linked list container.
-  std::forward_list<Book> books_sl_list_;  
+  std::pmr::forward_list<Book> books_sl_list_{node_pool_.get()};
 
   // The doubly-linked list container.
-  std::list<Book> books_dl_list_;
+  std::pmr::list<Book> books_dl_list_{node_pool_.get()};
+
+  // The secondary indexes below allocate from node_pool_, so that they too
+  // draw on the list's resource and reuse the memory remove() frees. Their
+  // string keys compare transparently, so lookups by std::string_view build
+  // no key.
+
+  // The author index, mapping each author to the ascending offsets of their
+  // books.
+  std::pmr::map<std::pmr::string, std::pmr::vector<std::size_t>, std::less<>>
+      books_by_author_{node_pool_.get()};
+
+  // The title index, holding every title in lexicographic order.
+  std::pmr::vector<std::pmr::string> sorted_titles_{node_pool_.get()};
+
+  // The price column, holding each book's price in list order for the
+  // aggregation kernels.
+  std::pmr::vector<double> prices_{node_pool_.get()};
+
+  // The full-text index, mapping each word in a title or author to the
+  // ascending ids of the books containing it. Each posting list is stored as
+  // varint-encoded gaps between consecutive ids.
+  std::pmr::map<std::pmr::string, std::pmr::string, std::less<>>
+      postings_by_word_{node_pool_.get()};
+
+  // The id of each book, in list order. A book keeps its id while it stays in
+  // the list, however the list is reordered, so inserting or removing a book
+  // touches only the posting lists of its own words.
+  std::pmr::vector<std::size_t> book_ids_{node_pool_.get()};
+
+  // The id the next inserted book gets, larger than any in use.
+  std::size_t next_book_id_ = 0;
+
+  // The sorted views, one per SortKey, pointing into books_dl_list_ since
+  // its elements never move. The PRICE view doubles as the price index.
+  std::array<std::pmr::set<const Book*, KeyOrder>, 4> sorted_views_ =
+      sorted_views_over(books_dl_list_, node_pool_.get());
+
+  // The change feed.
+  ChangeFeed change_feed_;
+
+  // The version of the list's contents, advanced by every change.
+  std::uint64_t version_ = 0;
 };
 
+//
+// Removal
+//
+
+// Removes every book in book_list for which predicate returns true, as
+// std::erase_if does for standard containers, and returns the number removed.
+std::size_t erase_if(BookList& book_list,
+                     const std::function<bool(const Book&)>& predicate);
+
 //
 // Relational Operators
 //
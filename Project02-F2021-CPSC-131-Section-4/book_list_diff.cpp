@@ -0,0 +1,146 @@
+#include "book_list_diff.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+namespace {
+
+// Returns whether each element of sequence belongs to one longest strictly
+// increasing subsequence, found by patience sorting.
+std::vector<bool> longest_increasing(const std::vector<std::size_t>& sequence) {
+  // tails[k] is the index of the smallest value ending an increasing run of
+  // length k + 1, and previous links each element to its predecessor.
+  std::vector<std::size_t> tails;
+  std::vector<std::size_t> previous(sequence.size());
+  for (std::size_t i = 0; i < sequence.size(); ++i) {
+    auto pile = std::lower_bound(
+        tails.begin(), tails.end(), sequence[i],
+        [&](std::size_t tail, std::size_t value) {
+          return sequence[tail] < value;
+        });
+    previous[i] = pile == tails.begin() ? i : *std::prev(pile);
+    if (pile == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *pile = i;
+    }
+  }
+
+  std::vector<bool> in_subsequence(sequence.size(), false);
+  if (!tails.empty()) {
+    for (std::size_t i = tails.back();; i = previous[i]) {
+      in_subsequence[i] = true;
+      if (previous[i] == i) {
+        break;
+      }
+    }
+  }
+  return in_subsequence;
+}
+
+}  // namespace
+
+EditScript diff(const BookList& from, const BookList& to) {
+  // Walk the lists by iterator, since size() and at() each check the whole
+  // list first.
+  const std::size_t from_size = from.size();
+  const std::size_t to_size = to.size();
+  const BookList::const_iterator to_books = to.begin();
+
+  // Locate each of to's books by hash.
+  std::unordered_map<Book, std::size_t> offset_in_to;
+  offset_in_to.reserve(to_size);
+  for (std::size_t j = 0; j < to_size; ++j) {
+    offset_in_to.emplace(to_books[j], j);
+  }
+
+  EditScript script;
+
+  // Remove the books to lacks, bottom first so earlier offsets hold. The
+  // survivors are recorded by their offset in to.
+  std::vector<std::size_t> survivors;
+  std::vector<bool> removed(from_size, false);
+  std::size_t offset = 0;
+  for (const Book& book : from) {
+    auto match = offset_in_to.find(book);
+    if (match == offset_in_to.end()) {
+      removed[offset] = true;
+    } else {
+      survivors.push_back(match->second);
+    }
+    ++offset;
+  }
+  for (std::size_t i = from_size; i-- > 0;) {
+    if (removed[i]) {
+      script.edits.push_back({BookList::Change::Kind::REMOVED, i, 0, {}});
+    }
+  }
+
+  // Survivors already in relative order stay put; the rest are moved.
+  std::vector<bool> in_place(to_size, false);
+  const std::vector<bool> increasing = longest_increasing(survivors);
+  std::vector<bool> in_from(to_size, false);
+  for (std::size_t k = 0; k < survivors.size(); ++k) {
+    in_from[survivors[k]] = true;
+    in_place[survivors[k]] = increasing[k];
+  }
+
+  // Walk to in order, placing each book just after its predecessor. The
+  // books before it in to are all in place by then.
+  std::vector<std::size_t> current = survivors;
+  for (std::size_t j = 0; j < to_size; ++j) {
+    if (in_place[j]) {
+      continue;
+    }
+
+    std::size_t target = 0;
+    if (j > 0) {
+      target = std::find(current.begin(), current.end(), j - 1)
+          - current.begin() + 1;
+    }
+
+    if (!in_from[j]) {
+      script.edits.push_back(
+          {BookList::Change::Kind::INSERTED, target, 0, to_books[j]});
+      current.insert(current.begin() + target, j);
+      continue;
+    }
+
+    const std::size_t source =
+        std::find(current.begin(), current.end(), j) - current.begin();
+    current.erase(current.begin() + source);
+    if (source < target) {
+      --target;
+    }
+    current.insert(current.begin() + target, j);
+    script.edits.push_back({BookList::Change::Kind::MOVED, source, target, {}});
+  }
+
+  return script;
+}
+
+void apply(BookList& book_list, const EditScript& script) {
+  for (const BookList::Change& change : script.edits) {
+    switch (change.kind) {
+      case BookList::Change::Kind::INSERTED: {
+        book_list.insert(change.book, change.offset);
+        break;
+      }
+      case BookList::Change::Kind::REMOVED: {
+        book_list.remove(change.offset);
+        break;
+      }
+      case BookList::Change::Kind::MOVED: {
+        const Book book = book_list.at(change.offset);
+        book_list.remove(change.offset).insert(book, change.to);
+        break;
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef _book_list_diff_hpp_
+#define _book_list_diff_hpp_
+
+#include <vector>
+
+#include "book_list.hpp"
+
+// Functions for computing and replaying the differences between two book
+// lists.
+
+// A sequence of edits with the same meaning as the changes delivered to
+// change-feed subscribers: INSERTED puts a book at an offset, REMOVED drops
+// the book at an offset, and MOVED removes the book at offset and reinserts
+// it at to.
+struct EditScript {
+  std::vector<BookList::Change> edits;
+};
+
+// Returns a minimal edit script turning from into to.
+//
+// Books present only in from are removed, books present only in to are
+// inserted, and of the books in both, those outside a longest common
+// subsequence are moved. Books are matched by hash and the subsequence is
+// found by patience sorting, so for lists of up to n books the cost is
+// O(n log n), plus O(n) for each insertion or move to find its place.
+EditScript diff(const BookList& from, const BookList& to);
+
+// Applies the edit script to book_list.
+void apply(BookList& book_list, const EditScript& script);
+
+#endif
\ No newline at end of file
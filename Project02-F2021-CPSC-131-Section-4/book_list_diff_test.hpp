@@ -0,0 +1,53 @@
+// Unit tests for the book list diff functions.
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "book_list_diff.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("Diff") {
+  const Book book_1("book_1"),
+      book_2("book_2"),
+      book_3("book_3"),
+      book_4("book_4"),
+      book_5("book_5"),
+      book_6("book_6");
+
+  const BookList from = {book_1, book_2, book_3, book_4, book_5};
+
+  SUBCASE("Identical") {
+    CHECK(diff(from, from).edits.empty());
+  }
+
+  SUBCASE("SingleMove") {
+    const BookList to = {book_2, book_3, book_4, book_5, book_1};
+    const EditScript script = diff(from, to);
+    REQUIRE_EQ(1U, script.edits.size());
+    CHECK(script.edits[0].kind == BookList::Change::Kind::MOVED);
+    CHECK_EQ(0U, script.edits[0].offset);
+    CHECK_EQ(4U, script.edits[0].to);
+
+    BookList list(from);
+    apply(list, script);
+    CHECK_EQ(to, list);
+  }
+
+  SUBCASE("InsertsRemovesAndMoves") {
+    const BookList to = {book_6, book_4, book_1, book_3, book_5};
+    const EditScript script = diff(from, to);
+    // Remove book_2, insert book_6, and move book_4 ahead of book_1.
+    CHECK_EQ(3U, script.edits.size());
+
+    BookList list(from);
+    apply(list, script);
+    CHECK_EQ(to, list);
+  }
+
+  SUBCASE("ToAndFromEmpty") {
+    BookList list(from);
+    apply(list, diff(from, BookList()));
+    CHECK_EQ(BookList(), list);
+    apply(list, diff(BookList(), from));
+    CHECK_EQ(from, list);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "book_list_history.hpp"
+
+#include <cstddef>
+#include <utility>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+//
+// Constructors, Assignments, and Destructor
+//
+
+BookListHistory::BookListHistory(BookList& book_list,
+                                 std::size_t memory_budget)
+    : book_list_(book_list), memory_budget_(memory_budget) {}
+
+//
+// Journaled Mutators
+//
+
+BookListHistory& BookListHistory::insert(const Book& book,
+                                         BookList::Position position) {
+  // Convert the TOP and BOTTOM enumerations to an offset and delegate the work.
+  return insert(book, position == BookList::Position::TOP
+                          ? 0
+                          : book_list_.size());
+}
+
+BookListHistory& BookListHistory::insert(const Book& book,
+                                         std::size_t offset_from_top) {
+  const std::size_t size = book_list_.size();
+  book_list_.insert(book, offset_from_top);
+  if (book_list_.size() != size) {
+    record({Step::Kind::INSERT, book, offset_from_top});
+  }
+  return *this;
+}
+
+BookListHistory& BookListHistory::remove(const Book& book) {
+  return remove(book_list_.find(book));
+}
+
+BookListHistory& BookListHistory::remove(std::size_t offset_from_top) {
+  if (offset_from_top < book_list_.size()) {
+    Book book = book_list_.at(offset_from_top);
+    book_list_.remove(offset_from_top);
+    record({Step::Kind::REMOVE, std::move(book), offset_from_top});
+  }
+  return *this;
+}
+
+BookListHistory& BookListHistory::move_to_top(const Book& book) {
+  const std::size_t offset_from_top = book_list_.find(book);
+  if (offset_from_top != 0 && offset_from_top < book_list_.size()) {
+    book_list_.move(offset_from_top, 0);
+    record({Step::Kind::MOVE_TO_TOP, book, offset_from_top});
+  }
+  return *this;
+}
+
+//
+// Undo and Redo
+//
+
+bool BookListHistory::undo() {
+  if (undo_.empty()) {
+    return false;
+  }
+
+  Step step = std::move(undo_.back());
+  undo_.pop_back();
+  switch (step.kind) {
+    case Step::Kind::INSERT: {
+      book_list_.remove(step.offset_from_top);
+      break;
+    }
+    case Step::Kind::REMOVE: {
+      book_list_.insert(step.book, step.offset_from_top);
+      break;
+    }
+    case Step::Kind::MOVE_TO_TOP: {
+      book_list_.move(0, step.offset_from_top);
+      break;
+    }
+  }
+  redo_.push_back(std::move(step));
+  return true;
+}
+
+bool BookListHistory::redo() {
+  if (redo_.empty()) {
+    return false;
+  }
+
+  Step step = std::move(redo_.back());
+  redo_.pop_back();
+  switch (step.kind) {
+    case Step::Kind::INSERT: {
+      book_list_.insert(step.book, step.offset_from_top);
+      break;
+    }
+    case Step::Kind::REMOVE: {
+      book_list_.remove(step.offset_from_top);
+      break;
+    }
+    case Step::Kind::MOVE_TO_TOP: {
+      book_list_.move(step.offset_from_top, 0);
+      break;
+    }
+  }
+  undo_.push_back(std::move(step));
+  return true;
+}
+
+std::size_t BookListHistory::undo_steps() const {
+  return undo_.size();
+}
+
+std::size_t BookListHistory::redo_steps() const {
+  return redo_.size();
+}
+
+std::size_t BookListHistory::memory_used() const {
+  return memory_used_;
+}
+
+//
+// Helpers
+//
+
+std::size_t BookListHistory::bytes_of(const Step& step) {
+  return sizeof(Step) + step.book.isbn().size()
+      + step.book.title().size() + step.book.author().size();
+}
+
+void BookListHistory::record(Step step) {
+  // A new edit forks history, so the undone steps can no longer be redone.
+  for (const Step& undone : redo_) {
+    memory_used_ -= bytes_of(undone);
+  }
+  redo_.clear();
+
+  memory_used_ += bytes_of(step);
+  undo_.push_back(std::move(step));
+
+  while (memory_used_ > memory_budget_ && !undo_.empty()) {
+    memory_used_ -= bytes_of(undo_.front());
+    undo_.pop_front();
+  }
+}
\ No newline at end of file
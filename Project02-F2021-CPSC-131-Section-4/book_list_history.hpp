@@ -0,0 +1,108 @@
+#ifndef _book_list_history_hpp_
+#define _book_list_history_hpp_
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// The BookListHistory class edits a book list while journaling each change as
+// its compact inverse, giving multi-level undo and redo.
+//
+// Only the changed book and its offset are kept per step, never a copy of the
+// list. Once the journal outgrows its memory budget the oldest steps are
+// forgotten.
+class BookListHistory {
+ public:
+  //
+  // Constructors, Assignments, and Destructor
+  //
+
+  // Journals edits to book_list, which must outlive the history, keeping at
+  // most memory_budget bytes of steps.
+  explicit BookListHistory(BookList& book_list,
+                           std::size_t memory_budget = 1 << 20);
+
+  BookListHistory(const BookListHistory& other) = delete;
+
+  BookListHistory& operator=(const BookListHistory& rhs) = delete;
+
+  //
+  // Journaled Mutators
+  //
+  // Each behaves like the BookList method of the same name. A call that
+  // leaves the list unchanged is not journaled, so repeating move_to_top on
+  // the book already at the top costs no undo step.
+
+  BookListHistory& insert(
+      const Book& book,
+      BookList::Position position = BookList::Position::TOP);
+
+  BookListHistory& insert(const Book& book, std::size_t offset_from_top);
+
+  BookListHistory& remove(const Book& book);
+
+  BookListHistory& remove(std::size_t offset_from_top);
+
+  BookListHistory& move_to_top(const Book& book);
+
+  //
+  // Undo and Redo
+  //
+
+  // Reverts the most recent step. Returns false if there is none.
+  bool undo();
+
+  // Reapplies the most recently undone step. Returns false if there is none.
+  bool redo();
+
+  // Returns the number of steps that can be undone.
+  std::size_t undo_steps() const;
+
+  // Returns the number of steps that can be redone.
+  std::size_t redo_steps() const;
+
+  // Returns the approximate number of bytes held by the journal.
+  std::size_t memory_used() const;
+
+ private:
+  // One journaled edit and what is needed to reverse it.
+  struct Step {
+    enum class Kind {INSERT, REMOVE, MOVE_TO_TOP};
+
+    Kind kind;
+
+    // The book inserted, removed, or moved.
+    Book book;
+
+    // Where the book was inserted or removed, or where it was before moving
+    // to the top.
+    std::size_t offset_from_top;
+  };
+
+  // Returns the approximate number of bytes held by step.
+  static std::size_t bytes_of(const Step& step);
+
+  // Journals a new step, forgetting redo steps and then the oldest undo steps
+  // as needed to stay within budget.
+  void record(Step step);
+
+  // The book list being edited.
+  BookList& book_list_;
+
+  // The most bytes the journal may hold.
+  std::size_t memory_budget_;
+
+  // The bytes currently held by undo_ and redo_.
+  std::size_t memory_used_ = 0;
+
+  // The steps that can be undone, oldest first.
+  std::deque<Step> undo_;
+
+  // The steps that can be redone, most recently undone last.
+  std::vector<Step> redo_;
+};
+
+#endif
\ No newline at end of file
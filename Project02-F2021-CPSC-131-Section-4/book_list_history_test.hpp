@@ -0,0 +1,72 @@
+// Unit tests for the BookListHistory class.
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "book_list_history.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("UndoRedo") {
+  const Book book_1("book_1"),
+      book_2("book_2"),
+      book_3("book_3"),
+      book_4("book_4");
+
+  BookList list = {book_1, book_2, book_3};
+  BookListHistory history(list);
+
+  SUBCASE("EachOperation") {
+    history.insert(book_4, 1U)
+        .remove(book_1)
+        .move_to_top(book_3)
+        .insert(book_1, BookList::Position::BOTTOM)
+        .remove(0U);
+    CHECK_EQ(BookList({book_4, book_2, book_1}), list);
+    CHECK_EQ(5U, history.undo_steps());
+
+    CHECK(history.undo());
+    CHECK_EQ(BookList({book_3, book_4, book_2, book_1}), list);
+    CHECK(history.undo());
+    CHECK_EQ(BookList({book_3, book_4, book_2}), list);
+    CHECK(history.undo());
+    CHECK_EQ(BookList({book_4, book_2, book_3}), list);
+    CHECK(history.undo());
+    CHECK_EQ(BookList({book_1, book_4, book_2, book_3}), list);
+    CHECK(history.undo());
+    CHECK_EQ(BookList({book_1, book_2, book_3}), list);
+    CHECK_FALSE(history.undo());
+    CHECK_EQ(5U, history.redo_steps());
+
+    while (history.redo()) {
+    }
+    CHECK_EQ(BookList({book_4, book_2, book_1}), list);
+    CHECK_EQ(0U, history.redo_steps());
+  }
+
+  SUBCASE("NewEditDropsRedo") {
+    history.remove(book_2);
+    history.undo();
+    history.insert(book_4);
+    CHECK_EQ(0U, history.redo_steps());
+    CHECK_FALSE(history.redo());
+    CHECK_EQ(BookList({book_4, book_1, book_2, book_3}), list);
+  }
+
+  SUBCASE("NoOpsAreNotJournaled") {
+    history.move_to_top(book_3).move_to_top(book_3).move_to_top(book_3);
+    history.insert(book_1).remove(Book("not there")).remove(10U);
+    CHECK_EQ(1U, history.undo_steps());
+    history.undo();
+    CHECK_EQ(BookList({book_1, book_2, book_3}), list);
+  }
+
+  SUBCASE("MemoryBudget") {
+    CHECK_EQ(0U, history.memory_used());
+    history.remove(0U);
+    const std::size_t step = history.memory_used();
+    CHECK_GT(step, 0U);
+    BookListHistory bounded(list, 2 * step);
+    bounded.remove(0U).insert(book_1).insert(book_2).insert(book_4);
+    CHECK_EQ(2U, bounded.undo_steps());
+    CHECK_LE(bounded.memory_used(), 2 * step);
+  }
+}
\ No newline at end of file
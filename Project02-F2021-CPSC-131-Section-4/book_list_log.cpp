@@ -0,0 +1,302 @@
+#include "book_list_log.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "file_io.hpp"
+
+namespace {
+
+// Returns message followed by the description of the current errno.
+std::string describe(const std::string& message) {
+  return message + ": " + std::strerror(errno);
+}
+
+// Returns book in the form Book's operator>> reads, with the price written in
+// full so that it reads back exactly.
+std::string format_book(const Book& book) {
+  std::ostringstream fields;
+  fields << std::quoted(book.isbn()) << ',' << std::quoted(book.title()) << ','
+         << std::quoted(book.author()) << ',';
+  char digits[32];
+  auto [end, error] =
+      std::to_chars(digits, digits + sizeof digits, book.price());
+  return fields.str().append(digits, end);
+}
+
+// Flushes the directory holding path to disk, so a rename within it
+// survives a crash.
+bool sync_directory(const std::string& path) {
+  std::string directory = std::filesystem::path(path).parent_path().string();
+  if (directory.empty()) {
+    directory = ".";
+  }
+  const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd < 0) {
+    return false;
+  }
+  const bool synced = ::fsync(fd) == 0;
+  ::close(fd);
+  return synced;
+}
+
+// Writes bytes to a file beside path, syncs it, and renames it over path.
+bool replace_file(const std::string& path, const std::string& bytes) {
+  const std::string temp_path = path + ".tmp";
+  const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  const bool written = write_all(fd, bytes) && ::fsync(fd) == 0;
+  ::close(fd);
+  return written && std::rename(temp_path.c_str(), path.c_str()) == 0
+         && sync_directory(path);
+}
+
+}  // namespace
+
+//
+// Constructors, Assignments, and Destructor
+//
+
+BookListLog::BookListLog(const std::string& path,
+                         std::size_t records_per_sync)
+    : path_(path),
+      fd_(::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)),
+      records_per_sync_(records_per_sync) {
+  if (fd_ < 0) {
+    throw LogException(describe("Cannot open log " + path));
+  }
+
+  // Carry on numbering from the last whole record, and cut off any torn one
+  // so the next record does not run into it.
+  std::ifstream log(path, std::ios::binary);
+  std::string line;
+  std::size_t whole_bytes = 0;
+  while (std::getline(log, line) && !log.eof()) {
+    whole_bytes += line.size() + 1;
+    std::istringstream(line) >> sequence_;
+  }
+  if (log.eof() && !line.empty()
+      && ::ftruncate(fd_, static_cast<off_t>(whole_bytes)) != 0) {
+    ::close(fd_);
+    throw LogException(describe("Cannot truncate torn record in " + path));
+  }
+}
+
+BookListLog::~BookListLog() {
+  // Destructors must not throw, so a failed final commit is dropped.
+  try {
+    flush();
+  } catch (const LogException&) {
+  }
+  ::close(fd_);
+}
+
+//
+// Logged Mutators
+//
+
+BookListLog& BookListLog::insert(BookList& book_list, const Book& book,
+                                 BookList::Position position) {
+  book_list.insert(book, position);
+  append_record((position == BookList::Position::TOP ? "I 0 " : "B ")
+                + format_book(book));
+  return *this;
+}
+
+BookListLog& BookListLog::insert(BookList& book_list, const Book& book,
+                                 std::size_t offset_from_top) {
+  book_list.insert(book, offset_from_top);
+  append_record("I " + std::to_string(offset_from_top) + ' '
+                + format_book(book));
+  return *this;
+}
+
+BookListLog& BookListLog::remove(BookList& book_list, const Book& book) {
+  return remove(book_list, book_list.find(book));
+}
+
+BookListLog& BookListLog::remove(BookList& book_list,
+                                 std::size_t offset_from_top) {
+  // Removing past the end changes nothing, so there is nothing to log.
+  if (offset_from_top >= book_list.size()) {
+    return *this;
+  }
+  book_list.remove(offset_from_top);
+  append_record("R " + std::to_string(offset_from_top));
+  return *this;
+}
+
+BookListLog& BookListLog::move_to_top(BookList& book_list, const Book& book) {
+  // Log the move by offset, which replays exactly, and log nothing if the
+  // book is not there to move.
+  const std::size_t offset_from_top = book_list.find(book);
+  if (offset_from_top == book_list.size()) {
+    return *this;
+  }
+  book_list.move(offset_from_top, 0);
+  append_record("M " + std::to_string(offset_from_top));
+  return *this;
+}
+
+BookListLog& BookListLog::append(BookList& book_list, const BookList& rhs) {
+  // Add the books as one batch, which finds the ones already held by hash
+  // rather than with a find() per book.
+  const std::size_t old_size = book_list.size();
+  auto next = rhs.begin();
+  book_list.append_unique([&](Book& book) {
+    if (next == rhs.end()) {
+      return false;
+    }
+    book = *next++;
+    return true;
+  });
+
+  // Log each book added as an insertion at the bottom, which replays exactly
+  // as operator+= applies it.
+  for (auto book = book_list.begin() + old_size; book != book_list.end();
+       ++book) {
+    append_record("B " + format_book(*book));
+  }
+  return *this;
+}
+
+//
+// Durability
+//
+
+void BookListLog::append_record(const std::string& record) {
+  buffer_ += std::to_string(++sequence_) + ' ' + record + '\n';
+  ++buffered_records_;
+  if (records_per_sync_ != 0 && buffered_records_ >= records_per_sync_) {
+    flush();
+  }
+}
+
+void BookListLog::flush() {
+  if (buffered_records_ == 0) {
+    return;
+  }
+  if (!write_all(fd_, buffer_)) {
+    throw LogException(describe("Cannot write log"));
+  }
+  if (::fsync(fd_) != 0) {
+    throw LogException(describe("Cannot sync log"));
+  }
+  buffer_.clear();
+  buffered_records_ = 0;
+}
+
+void BookListLog::checkpoint(const BookList& book_list,
+                             const std::string& snapshot_path) {
+  flush();
+
+  // Replace the snapshot, stamped with the last record it includes, so a
+  // crash leaves either the old snapshot or the new one, never a mix.
+  std::string snapshot =
+      std::to_string(sequence_) + '\n' + std::to_string(book_list.size());
+  std::size_t index = 0;
+  for (const Book& book : book_list) {
+    snapshot += "\n" + std::to_string(index++) + ":  " + format_book(book);
+  }
+  snapshot += '\n';
+  if (!replace_file(snapshot_path, snapshot)) {
+    throw LogException(describe("Cannot replace snapshot " + snapshot_path));
+  }
+
+  // Every change logged so far is now in the snapshot, so replace the log
+  // with one that only keeps the numbering going. A crash before this leaves
+  // the old log, whose records recover() skips.
+  if (!replace_file(path_, std::to_string(sequence_) + " C\n")) {
+    throw LogException(describe("Cannot replace log " + path_));
+  }
+  ::close(fd_);
+  fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND);
+  if (fd_ < 0) {
+    throw LogException(describe("Cannot reopen log " + path_));
+  }
+}
+
+BookList BookListLog::recover(const std::string& snapshot_path,
+                              const std::string& log_path) {
+  BookList book_list;
+  std::size_t snapshot_sequence = 0;
+  std::ifstream snapshot(snapshot_path);
+  if (snapshot) {
+    snapshot >> snapshot_sequence >> book_list;
+  }
+
+  // Every record ends in a newline, so a record without one was torn.
+  // Records the snapshot already includes are read but not applied.
+  std::ifstream log(log_path);
+  std::size_t sequence = 0;
+  char operation;
+  while (log >> sequence >> operation) {
+    const bool apply = sequence > snapshot_sequence;
+    std::size_t offset_from_top = 0;
+    Book book;
+    switch (operation) {
+      case 'I': {
+        if (!(log >> offset_from_top >> book) || log.get() != '\n') {
+          return book_list;
+        }
+        if (apply) {
+          book_list.insert(book, offset_from_top);
+        }
+        break;
+      }
+      case 'B': {
+        if (!(log >> book) || log.get() != '\n') {
+          return book_list;
+        }
+        if (apply) {
+          book_list.insert(book, BookList::Position::BOTTOM);
+        }
+        break;
+      }
+      case 'R': {
+        if (!(log >> offset_from_top) || log.get() != '\n') {
+          return book_list;
+        }
+        if (apply) {
+          book_list.remove(offset_from_top);
+        }
+        break;
+      }
+      case 'M': {
+        if (!(log >> offset_from_top) || log.get() != '\n') {
+          return book_list;
+        }
+        if (apply) {
+          book_list.move(offset_from_top, 0);
+        }
+        break;
+      }
+      case 'C': {
+        // A checkpoint marker only carries the numbering.
+        if (log.get() != '\n') {
+          return book_list;
+        }
+        break;
+      }
+      default: {
+        return book_list;
+      }
+    }
+  }
+  return book_list;
+}
\ No newline at end of file
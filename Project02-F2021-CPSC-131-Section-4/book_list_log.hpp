@@ -0,0 +1,114 @@
+#ifndef _book_list_log_hpp_
+#define _book_list_log_hpp_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// The BookListLog class is an append-only write-ahead log of the changes made
+// to a book list. Together with a snapshot written by checkpoint(), the log
+// lets recover() rebuild the list after a crash.
+//
+// Records are buffered and committed as a group: every records_per_sync
+// records are written to the file and flushed to disk with fsync. A crash can
+// therefore lose at most the last records_per_sync - 1 changes.
+//
+// Each record carries a sequence number, and each snapshot the number of the
+// last record it includes, so recover() never replays a change twice even if
+// a crash interrupts checkpoint().
+class BookListLog {
+ public:
+  //
+  // Types and Exceptions
+  //
+
+  // Thrown if the log or snapshot file cannot be opened, written, or synced.
+  struct LogException : std::runtime_error {
+    using runtime_error::runtime_error;
+  };
+
+  //
+  // Constructors, Assignments, and Destructor
+  //
+
+  // Opens the log at path for appending, creating it if needed, and drops any
+  // record torn by a crash from its end. A records_per_sync of zero commits
+  // only on flush() and destruction.
+  explicit BookListLog(const std::string& path,
+                       std::size_t records_per_sync = 1);
+
+  BookListLog(const BookListLog& other) = delete;
+
+  BookListLog& operator=(const BookListLog& rhs) = delete;
+
+  // The destructor commits any buffered records.
+  ~BookListLog();
+
+  //
+  // Logged Mutators
+  //
+  // Each applies the change to book_list, then logs it. Changes that throw
+  // are not logged.
+
+  BookListLog& insert(BookList& book_list, const Book& book,
+                      BookList::Position position = BookList::Position::TOP);
+
+  BookListLog& insert(BookList& book_list, const Book& book,
+                      std::size_t offset_from_top);
+
+  BookListLog& remove(BookList& book_list, const Book& book);
+
+  BookListLog& remove(BookList& book_list, std::size_t offset_from_top);
+
+  BookListLog& move_to_top(BookList& book_list, const Book& book);
+
+  // Logs `book_list += rhs`, adding the books rhs has that book_list lacks as
+  // one batch with BookList::append_unique().
+  BookListLog& append(BookList& book_list, const BookList& rhs);
+
+  //
+  // Durability
+  //
+
+  // Writes and syncs any buffered records.
+  void flush();
+
+  // Atomically replaces the snapshot at snapshot_path with book_list, then
+  // atomically replaces the log with one holding only the sequence number
+  // reached, since every logged change is now in the snapshot.
+  void checkpoint(const BookList& book_list, const std::string& snapshot_path);
+
+  // Returns the book list in the snapshot at snapshot_path, or an empty list
+  // if there is none, with the log at log_path replayed on top. A record torn
+  // by a crash ends the replay.
+  static BookList recover(const std::string& snapshot_path,
+                          const std::string& log_path);
+
+ private:
+  // Buffers one record, numbering it and committing the group once it is
+  // full.
+  void append_record(const std::string& record);
+
+  // The log file's path.
+  std::string path_;
+
+  // The log file's descriptor.
+  int fd_ = -1;
+
+  // The sequence number of the last record logged.
+  std::size_t sequence_ = 0;
+
+  // The number of records committed together.
+  std::size_t records_per_sync_ = 1;
+
+  // The records not yet written to the file.
+  std::string buffer_;
+
+  // The number of records in buffer_.
+  std::size_t buffered_records_ = 0;
+};
+
+#endif
\ No newline at end of file
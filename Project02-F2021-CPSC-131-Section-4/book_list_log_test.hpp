@@ -0,0 +1,116 @@
+// Unit tests for the BookListLog class.
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "book_list_log.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("WriteAheadLog") {
+  const Book book_1("book_1", "", "1", 1.0),
+      book_2("book_2", "", "2", 2.0),
+      book_3("book_3", "", "3", 3.0),
+      book_4("book_4", "", "4", 4.0);
+
+  const std::string directory = std::filesystem::temp_directory_path().string();
+  const std::string log_path = directory + "/book_list_log_test.wal";
+  const std::string snapshot_path = directory + "/book_list_log_test.snapshot";
+  std::remove(log_path.c_str());
+  std::remove(snapshot_path.c_str());
+
+  SUBCASE("ReplaysEveryOperation") {
+    BookList list;
+    {
+      BookListLog log(log_path);
+      log.insert(list, book_1)
+          .insert(list, book_2, BookList::Position::BOTTOM)
+          .insert(list, book_3, 1U)
+          .move_to_top(list, book_2)
+          .remove(list, book_1)
+          .remove(list, Book("not there"))
+          .append(list, BookList({book_4, book_3}))
+          .append(list, list);
+    }
+    CHECK_EQ(BookList({book_2, book_3, book_4}), list);
+    CHECK_EQ(list, BookListLog::recover(snapshot_path, log_path));
+  }
+
+  SUBCASE("GroupCommit") {
+    BookList list;
+    BookListLog log(log_path, 3U);
+    log.insert(list, book_1).insert(list, book_2);
+    CHECK_EQ(BookList(), BookListLog::recover(snapshot_path, log_path));
+
+    log.insert(list, book_3);
+    CHECK_EQ(list, BookListLog::recover(snapshot_path, log_path));
+
+    log.remove(list, 0U);
+    log.flush();
+    CHECK_EQ(list, BookListLog::recover(snapshot_path, log_path));
+  }
+
+  SUBCASE("Checkpoint") {
+    BookList list;
+    BookListLog log(log_path);
+    log.insert(list, book_1).insert(list, book_2);
+    log.checkpoint(list, snapshot_path);
+    CHECK_EQ(list, BookListLog::recover(snapshot_path, log_path));
+
+    log.insert(list, book_3).remove(list, book_1);
+    CHECK_EQ(BookList({book_3, book_2}),
+             BookListLog::recover(snapshot_path, log_path));
+  }
+
+  SUBCASE("TornRecord") {
+    BookList list;
+    {
+      BookListLog log(log_path);
+      log.insert(list, book_1).insert(list, book_2);
+    }
+    std::ofstream(log_path, std::ios::app) << "3 I 0 \"3\",\"book_3\",\"\",3";
+    CHECK_EQ(BookList({book_2, book_1}),
+             BookListLog::recover(snapshot_path, log_path));
+
+    // Reopening the log drops the torn record, so later ones replay.
+    BookListLog(log_path).insert(list, book_4);
+    CHECK_EQ(BookList({book_4, book_2, book_1}),
+             BookListLog::recover(snapshot_path, log_path));
+  }
+
+  SUBCASE("CrashDuringCheckpoint") {
+    // A crash after the snapshot is replaced but before the log is leaves
+    // both holding the same changes; none may be applied twice.
+    const Book a("a", "", "a", 1.0), b("b", "", "b", 2.0);
+    BookList list;
+    BookListLog log(log_path);
+    log.insert(list, a, 0U).insert(list, b, 0U).remove(list, 1U);
+    const std::string saved_log = log_path + ".saved";
+    std::filesystem::copy_file(
+        log_path, saved_log, std::filesystem::copy_options::overwrite_existing);
+    log.checkpoint(list, snapshot_path);
+    std::filesystem::rename(saved_log, log_path);
+    CHECK_EQ(BookList({b}), BookListLog::recover(snapshot_path, log_path));
+
+    // Numbering carries on past the snapshot, so new records do replay.
+    BookListLog(log_path).insert(list, a, 1U);
+    CHECK_EQ(BookList({b, a}), BookListLog::recover(snapshot_path, log_path));
+  }
+
+  SUBCASE("ExactPrices") {
+    const Book precise("precise", "", "9", 12345.67),
+        tiny("tiny", "", "10", 0.1 + 0.2);
+    BookList list;
+    BookListLog log(log_path);
+    log.insert(list, precise).insert(list, tiny).move_to_top(list, precise);
+    CHECK_EQ(list, BookListLog::recover(snapshot_path, log_path));
+    log.checkpoint(list, snapshot_path);
+    CHECK_EQ(list, BookListLog::recover(snapshot_path, log_path));
+  }
+
+  std::remove(log_path.c_str());
+  std::remove(snapshot_path.c_str());
+}
\ No newline at end of file
@@ -1,7 +1,17 @@
 // Unit tests for the BookList class.
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <ranges>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "book.hpp"
 #include "book_list.hpp"
@@ -64,6 +74,127 @@ TEST_CASE("Accessors") {
   CHECK_EQ(4U, list1.find(book_5));
   CHECK_EQ(5U, list1.find(book_6));
   CHECK_EQ(6U, list1.find(Book("Unincluded Book")));
+
+  CHECK_EQ(book_3, list1.at(1U));
+  CHECK_EQ(book_6, list1.at(5U));
+  CHECK_THROWS_AS(list1.at(6U), BookList::InvalidOffsetException);
+}
+
+static_assert(std::ranges::random_access_range<const BookList>);
+static_assert(std::ranges::sized_range<const BookList>);
+static_assert(std::ranges::bidirectional_range<
+              decltype(std::declval<const BookList&>().list_view())>);
+
+TEST_CASE("Iteration") {
+  const Book zak_1("Programming with C++", "Diane Zak", "1", 31.99),
+      brown("Goodnight Moon", "Margaret Wise Brown", "2", 8.99),
+      zak_2("Programming with Java", "Diane Zak", "3", 29.99);
+
+  BookList list = {zak_1, brown, zak_2};
+
+  SUBCASE("RandomAccess") {
+    CHECK_EQ(std::vector<Book>({zak_1, brown, zak_2}),
+             std::vector<Book>(list.begin(), list.end()));
+    CHECK_EQ(std::vector<Book>({zak_2, brown, zak_1}),
+             std::vector<Book>(list.rbegin(), list.rend()));
+    CHECK_EQ(&list.at(1U), &list.begin()[1]);
+    CHECK_EQ(2, std::ranges::count_if(list, [](const Book& book) {
+               return book.author() == "Diane Zak";
+             }));
+    CHECK_EQ(list.begin() + 1, std::ranges::find(list, brown));
+    CHECK_FALSE(list.empty());
+    CHECK(BookList().empty());
+  }
+
+  SUBCASE("Slices") {
+    BookList::Slice page = list.slice(1U, 5U);
+    REQUIRE_EQ(2U, page.books.size());
+    CHECK_EQ(&list.at(1U), &page.books[0]);
+    CHECK_EQ(zak_2, page.books[1]);
+    CHECK_EQ(list.version(), page.version);
+    CHECK(list.slice(3U, 1U).books.empty());
+    CHECK_THROWS_AS(list.slice(4U, 1U), BookList::InvalidOffsetException);
+
+    // Every kind of change makes earlier pages stale.
+    list.move_to_top(zak_2);
+    CHECK_NE(page.version, list.version());
+    page = list.slice(0U, 1U);
+    list.remove(brown);
+    CHECK_NE(page.version, list.version());
+    page = list.slice(0U, 1U);
+    list = BookList({brown});
+    CHECK_NE(page.version, list.version());
+    page = list.slice(0U, 1U);
+    list.find(brown);
+    CHECK_EQ(page.version, list.version());
+  }
+
+  SUBCASE("LinkedList") {
+    auto view = list.list_view();
+    auto middle = std::ranges::next(view.begin());
+    CHECK_EQ(brown, *middle);
+
+    // The list iterator survives changes to other books.
+    list.remove(zak_1).insert(zak_1, BookList::Position::BOTTOM);
+    CHECK_EQ(brown, *middle);
+
+    std::vector<Book> reversed;
+    for (const Book& book : list.list_view() | std::views::reverse) {
+      reversed.push_back(book);
+    }
+    CHECK_EQ(std::vector<Book>({zak_1, zak_2, brown}), reversed);
+  }
+}
+
+TEST_CASE("AuthorIndex") {
+  const Book zak_1("Programming with C++", "Diane Zak", "1"),
+      zak_2("Programming with Java", "Diane Zak", "2"),
+      brown("Goodnight Moon", "Margaret Wise Brown", "3"),
+      zak_3("Programming with Python", "Diane Zak", "4");
+
+  BookList list = {zak_1, brown, zak_2};
+  CHECK_EQ(std::vector<std::size_t>({0U, 2U}), list.find_by_author("Diane Zak"));
+  CHECK_EQ(std::vector<std::size_t>({1U}),
+           list.find_by_author("Margaret Wise Brown"));
+  CHECK(list.find_by_author("Nobody").empty());
+
+  SUBCASE("Insert") {
+    list.insert(zak_3, 1U);
+    CHECK_EQ(std::vector<std::size_t>({0U, 1U, 3U}),
+             list.find_by_author("Diane Zak"));
+    CHECK_EQ(std::vector<std::size_t>({2U}),
+             list.find_by_author("Margaret Wise Brown"));
+  }
+
+  SUBCASE("Remove") {
+    list.remove(zak_1);
+    CHECK_EQ(std::vector<std::size_t>({1U}), list.find_by_author("Diane Zak"));
+    list.remove(brown);
+    CHECK(list.find_by_author("Margaret Wise Brown").empty());
+    CHECK_EQ(std::vector<std::size_t>({0U}), list.find_by_author("Diane Zak"));
+  }
+
+  SUBCASE("MoveToTop") {
+    list.move_to_top(brown);
+    CHECK_EQ(std::vector<std::size_t>({1U, 2U}),
+             list.find_by_author("Diane Zak"));
+    CHECK_EQ(std::vector<std::size_t>({0U}),
+             list.find_by_author("Margaret Wise Brown"));
+  }
+
+  SUBCASE("Swap") {
+    BookList other = {brown};
+    list.swap(other);
+    CHECK_EQ(std::vector<std::size_t>({0U}),
+             list.find_by_author("Margaret Wise Brown"));
+    CHECK(list.find_by_author("Diane Zak").empty());
+    CHECK_EQ(std::vector<std::size_t>({0U, 2U}),
+             other.find_by_author("Diane Zak"));
+  }
+
+  for (std::size_t offset : list.find_by_author("Diane Zak")) {
+    CHECK_EQ("Diane Zak", list.at(offset).author());
+  }
 }
 
 TEST_CASE("Modifiers") {
@@ -148,6 +279,702 @@ TEST_CASE("Modifiers") {
   }
 }
 
+TEST_CASE("EraseIf") {
+  const Book zak_1("Programming with C++", "Diane Zak", "1", 31.99),
+      brown_1("Goodnight Moon", "Margaret Wise Brown", "2", 8.99),
+      zak_2("Programming with Java", "Diane Zak", "3", 29.99),
+      brown_2("The Runaway Bunny", "Margaret Wise Brown", "4", 7.99),
+      zak_3("Programming in Python", "Diane Zak", "5", 45.00);
+
+  BookList list = {zak_1, brown_1, zak_2, brown_2, zak_3};
+
+  SUBCASE("KeepsOrderAndIndexes") {
+    std::size_t calls = 0;
+    CHECK_EQ(2U, erase_if(list, [&](const Book& book) {
+               ++calls;
+               return book.author() == "Margaret Wise Brown";
+             }));
+    CHECK_EQ(5U, calls);
+    CHECK_EQ(BookList({zak_1, zak_2, zak_3}), list);
+
+    CHECK(list.find_by_author("Margaret Wise Brown").empty());
+    CHECK_EQ(std::vector<std::size_t>({0U, 1U, 2U}),
+             list.find_by_author("Diane Zak"));
+    CHECK_EQ(std::vector<std::size_t>({2U}), list.search("python"));
+    CHECK(list.search("moon").empty());
+    CHECK(list.titles_with_prefix("Goodnight", 5U).empty());
+    CHECK_EQ(29.99, list.min_price());
+    CHECK_EQ(std::vector<Book>({zak_2}), list.k_cheapest(1U));
+    CHECK_EQ(zak_3, *list.sorted_view(BookList::SortKey::TITLE).begin());
+    CHECK_EQ(3U, list.sorted_view(BookList::SortKey::PRICE).size());
+
+    // The list still takes further changes.
+    list.insert(brown_1, 1U);
+    CHECK_EQ(std::vector<std::size_t>({0U, 2U, 3U}),
+             list.find_by_author("Diane Zak"));
+  }
+
+  SUBCASE("Extremes") {
+    const std::uint64_t version = list.version();
+    CHECK_EQ(0U, erase_if(list, [](const Book&) { return false; }));
+    CHECK_EQ(version, list.version());
+    CHECK_EQ(5U, list.size());
+
+    CHECK_EQ(5U, list.remove_if([](const Book&) { return true; }));
+    CHECK_EQ(BookList(), list);
+    CHECK(list.search("programming").empty());
+  }
+}
+
+TEST_CASE("Reordering") {
+  const Book book_1("Delta", "Zak", "1", 20.00),
+      book_2("Alpha", "Brown", "2", 10.00),
+      book_3("Charlie", "Zak", "3", 10.00),
+      book_4("Bravo", "Adams", "4", 30.00),
+      book_5("Echo", "Brown", "5", 10.00);
+
+  BookList list = {book_1, book_2, book_3, book_4, book_5};
+
+  SUBCASE("Move") {
+    list.move(0U, 3U);
+    CHECK_EQ(BookList({book_2, book_3, book_4, book_1, book_5}), list);
+    list.move(4U, 1U);
+    CHECK_EQ(BookList({book_2, book_5, book_3, book_4, book_1}), list);
+    list.move(2U, 2U);
+    CHECK_EQ(BookList({book_2, book_5, book_3, book_4, book_1}), list);
+    CHECK_THROWS_AS(list.move(5U, 0U), BookList::InvalidOffsetException);
+    CHECK_THROWS_AS(list.move(0U, 5U), BookList::InvalidOffsetException);
+
+    CHECK_EQ(std::vector<std::size_t>({2U, 4U}), list.find_by_author("Zak"));
+    CHECK_EQ(std::vector<std::size_t>({4U}), list.search("delta"));
+    CHECK_EQ(std::vector<std::size_t>({1U}), list.search("echo"));
+  }
+
+  SUBCASE("RotateAndReverse") {
+    list.rotate(2U);
+    CHECK_EQ(BookList({book_3, book_4, book_5, book_1, book_2}), list);
+    list.rotate(0U).rotate(5U);
+    CHECK_EQ(BookList({book_3, book_4, book_5, book_1, book_2}), list);
+    CHECK_THROWS_AS(list.rotate(6U), BookList::InvalidOffsetException);
+
+    list.reverse();
+    CHECK_EQ(BookList({book_2, book_1, book_5, book_4, book_3}), list);
+    CHECK_EQ(std::vector<std::size_t>({1U, 4U}), list.find_by_author("Zak"));
+  }
+
+  SUBCASE("Sort") {
+    // Books with equal keys keep their order.
+    list.sort(BookList::SortKey::PRICE);
+    CHECK_EQ(BookList({book_2, book_3, book_5, book_1, book_4}), list);
+    list.sort(BookList::SortKey::AUTHOR);
+    CHECK_EQ(BookList({book_4, book_2, book_5, book_3, book_1}), list);
+    list.sort(BookList::SortKey::TITLE);
+    CHECK_EQ(BookList({book_2, book_4, book_3, book_1, book_5}), list);
+
+    CHECK_EQ(std::vector<std::size_t>({2U, 3U}), list.find_by_author("Zak"));
+    CHECK_EQ(std::vector<std::size_t>({4U}), list.search("echo"));
+    CHECK_EQ(3U, list.find(book_1));
+
+    // The linked-list nodes are reused, so the sorted views still hold.
+    std::vector<Book> by_price;
+    for (const Book& book : list.sorted_view(BookList::SortKey::PRICE)) {
+      by_price.push_back(book);
+    }
+    CHECK_EQ(std::vector<Book>({book_2, book_3, book_5, book_1, book_4}),
+             by_price);
+  }
+
+  SUBCASE("ChangeFeed") {
+    BookList mirror(list);
+    list.subscribe([&](const std::vector<BookList::Change>& changes) {
+      for (const BookList::Change& change : changes) {
+        REQUIRE(change.kind == BookList::Change::Kind::MOVED);
+        const Book book = mirror.at(change.offset);
+        mirror.remove(change.offset).insert(book, change.to);
+      }
+    });
+
+    list.move(1U, 3U).rotate(3U).reverse().sort(BookList::SortKey::ISBN);
+    list.move_to_top(book_5);
+    list.flush_changes();
+    CHECK_EQ(list, mirror);
+  }
+}
+
+TEST_CASE("TitleIndex") {
+  const Book book_1("Programming with C++", "", "1"),
+      book_2("Programming with Java", "", "2"),
+      book_3("Goodnight Moon", "", "3"),
+      book_4("Programming with C++", "", "4"),
+      book_5("Pride and Prejudice", "", "5");
+
+  BookList list = {book_1, book_2, book_3, book_4, book_5};
+
+  CHECK_EQ(std::vector<std::string>({"Programming with C++",
+                                     "Programming with C++",
+                                     "Programming with Java"}),
+           list.titles_with_prefix("Prog", 10U));
+  CHECK_EQ(std::vector<std::string>({"Pride and Prejudice",
+                                     "Programming with C++"}),
+           list.titles_with_prefix("Pr", 2U));
+  CHECK_EQ(std::vector<std::string>({"Goodnight Moon"}),
+           list.titles_with_prefix("Goodnight Moon", 10U));
+  CHECK(list.titles_with_prefix("Goodnight Moons", 10U).empty());
+  CHECK(list.titles_with_prefix("Z", 10U).empty());
+  CHECK_EQ(5U, list.titles_with_prefix("", 10U).size());
+  CHECK_GE(list.title_index_bytes(), 5U * sizeof(std::string));
+
+  list.remove(book_4);
+  list.remove(book_2);
+  CHECK_EQ(std::vector<std::string>({"Programming with C++"}),
+           list.titles_with_prefix("Prog", 10U));
+}
+
+TEST_CASE("PriceIndex") {
+  const Book book_1("book_1", "", "1", 31.99),
+      book_2("book_2", "", "2", 8.99),
+      book_3("book_3", "", "3", 15.00),
+      book_4("book_4", "", "4", 8.99),
+      book_5("book_5", "", "5", 42.50);
+
+  BookList list = {book_1, book_2, book_3, book_4, book_5};
+
+  SUBCASE("Ranges") {
+    CHECK_EQ(5U, list.count_in_range(0.0, 100.0));
+    CHECK_EQ(3U, list.count_in_range(8.99, 15.00));
+    CHECK_EQ(0U, list.count_in_range(9.00, 14.99));
+    CHECK_EQ(0U, list.count_in_range(15.00, 8.99));
+    CHECK_EQ(std::vector<Book>({book_2, book_4, book_3}),
+             list.books_in_range(8.99, 15.00));
+    CHECK_EQ(std::vector<Book>({book_5}), list.books_in_range(42.50, 42.50));
+  }
+
+  SUBCASE("TopK") {
+    CHECK_EQ(std::vector<Book>({book_2, book_4}), list.k_cheapest(2U));
+    CHECK_EQ(std::vector<Book>({book_5, book_1, book_3}),
+             list.k_most_expensive(3U));
+    CHECK_EQ(5U, list.k_cheapest(10U).size());
+    CHECK(list.k_most_expensive(0U).empty());
+  }
+
+  SUBCASE("Reinsert") {
+    Book repriced(book_5);
+    repriced.price(1.00);
+    list.remove(book_5).insert(repriced);
+    CHECK_EQ(std::vector<Book>({repriced}), list.k_cheapest(1U));
+    CHECK_EQ(std::vector<Book>({book_1}), list.k_most_expensive(1U));
+  }
+}
+
+TEST_CASE("PriceAggregates") {
+  const Book book_1("book_1", "", "1", 31.99),
+      book_2("book_2", "", "2", 8.99),
+      book_3("book_3", "", "3", 15.00),
+      book_4("book_4", "", "4", 8.99);
+
+  BookList list;
+  CHECK_EQ(0.0, list.total_price());
+  CHECK_EQ(0.0, list.mean_price());
+  CHECK_EQ(0.0, list.max_price());
+
+  list += {book_1, book_2, book_3, book_4};
+  CHECK_EQ(doctest::Approx(64.97), list.total_price());
+  CHECK_EQ(doctest::Approx(16.2425), list.mean_price());
+  CHECK_EQ(8.99, list.min_price());
+  CHECK_EQ(31.99, list.max_price());
+  CHECK_EQ(std::vector<std::size_t>({2U, 1U, 0U, 1U}),
+           list.price_histogram(0.0, 40.0, 4U));
+
+  list.remove(book_1);
+  CHECK_EQ(doctest::Approx(32.98), list.total_price());
+  CHECK_EQ(15.00, list.max_price());
+
+  BookList other = {book_1};
+  list.swap(other);
+  CHECK_EQ(31.99, list.total_price());
+  CHECK_EQ(8.99, other.min_price());
+}
+
+TEST_CASE("FullTextSearch") {
+  const Book book_1("An Introduction to Programming with C++", "Diane Zak", "1"),
+      book_2("Goodnight Moon", "Margaret Wise Brown", "2"),
+      book_3("Programming: Principles and Practice", "Bjarne Stroustrup", "3"),
+      book_4("The Runaway Bunny", "Margaret Wise Brown", "4");
+
+  BookList list = {book_1, book_2, book_3, book_4};
+
+  SUBCASE("AllTerms") {
+    CHECK_EQ(std::vector<std::size_t>({0U, 2U}), list.search("programming"));
+    CHECK_EQ(std::vector<std::size_t>({1U, 3U}), list.search("MARGARET brown"));
+    CHECK_EQ(std::vector<std::size_t>({3U}), list.search("bunny, brown"));
+    CHECK(list.search("programming moon").empty());
+    CHECK(list.search("missing").empty());
+    CHECK(list.search("  ").empty());
+  }
+
+  SUBCASE("AnyTerm") {
+    CHECK_EQ(std::vector<std::size_t>({1U, 2U}),
+             list.search("moon stroustrup", BookList::Match::ANY));
+    CHECK_EQ(std::vector<std::size_t>({0U}),
+             list.search("missing zak", BookList::Match::ANY));
+  }
+
+  SUBCASE("Updates") {
+    list.remove(book_1);
+    CHECK_EQ(std::vector<std::size_t>({1U}), list.search("programming"));
+    list.move_to_top(book_4);
+    CHECK_EQ(std::vector<std::size_t>({0U, 1U}), list.search("margaret"));
+    list.insert(Book("Programming Pearls", "Jon Bentley", "5"), 1U);
+    CHECK_EQ(std::vector<std::size_t>({1U, 3U}), list.search("programming"));
+  }
+
+  SUBCASE("Reorders") {
+    // Books keep their place in the index as the list is reordered.
+    list.reverse();
+    CHECK_EQ(std::vector<std::size_t>({1U, 3U}), list.search("programming"));
+    list.rotate(1U);
+    CHECK_EQ(std::vector<std::size_t>({0U, 2U}), list.search("programming"));
+    CHECK_EQ(std::vector<std::size_t>({1U, 3U}), list.search("margaret"));
+    list.sort(BookList::SortKey::AUTHOR);
+    CHECK_EQ(std::vector<std::size_t>({0U, 1U}), list.search("programming"));
+    list.move(3U, 0U);
+    list.insert(Book("Programming Pearls", "Jon Bentley", "5"), 2U);
+    CHECK_EQ(std::vector<std::size_t>({1U, 2U, 3U}),
+             list.search("programming"));
+
+    const BookList copy(list);
+    CHECK_EQ(std::vector<std::size_t>({0U, 4U}), copy.search("margaret"));
+  }
+}
+
+TEST_CASE("FuzzyFind") {
+  const Book book_1("Introduction to Programming", "", "1"),
+      book_2("Goodnight Moon", "", "2"),
+      book_3("Introduction to Programs", "", "3"),
+      book_4(std::string(70, 'a') + "Long Title", "", "4"),
+      book_5(std::string(72, 'a') + "Long Title", "", "5");
+
+  const BookList list = {book_1, book_2, book_3, book_4, book_5};
+
+  CHECK_EQ(std::vector<std::size_t>({0U}),
+           list.fuzzy_find("Introduction to Programming", 0U, 10U));
+  CHECK_EQ(std::vector<std::size_t>({0U}),
+           list.fuzzy_find("Introdution to Programing", 2U, 10U));
+  CHECK(list.fuzzy_find("Introdution to Programing", 1U, 10U).empty());
+  CHECK_EQ(std::vector<std::size_t>({0U, 2U}),
+           list.fuzzy_find("Introduction to Program", 4U, 10U));
+  CHECK_EQ(std::vector<std::size_t>({0U}),
+           list.fuzzy_find("Introduction to Program", 4U, 1U));
+  CHECK_EQ(std::vector<std::size_t>({1U}),
+           list.fuzzy_find("Goodnite Moon", 3U, 10U));
+  CHECK_EQ(std::vector<std::size_t>({1U}),
+           list.fuzzy_find("goodnight moon", 2U, 10U));
+
+  // Patterns longer than a machine word take the row-by-row path.
+  CHECK_EQ(std::vector<std::size_t>({3U}),
+           list.fuzzy_find(std::string(69, 'a') + "Long Titel", 3U, 10U));
+  CHECK(list.fuzzy_find(std::string(69, 'a') + "Long Titel", 2U, 10U).empty());
+  CHECK_EQ(std::vector<std::size_t>({3U, 4U}),
+           list.fuzzy_find(std::string(69, 'a') + "Long Titel", 5U, 10U));
+}
+
+TEST_CASE("SortedViews") {
+  const Book book_1("Goodnight Moon", "Margaret Wise Brown", "3", 8.99),
+      book_2("An Introduction to Programming", "Diane Zak", "1", 31.99),
+      book_3("The C++ Programming Language", "Bjarne Stroustrup", "2", 54.00);
+
+  // Collects the titles of a view in iteration order.
+  auto titles = [](const BookList::SortedView& view) {
+    std::vector<std::string> result;
+    for (const Book& book : view) {
+      result.push_back(book.title());
+    }
+    return result;
+  };
+
+  BookList list = {book_1, book_2, book_3};
+  const BookList::SortedView by_title = list.sorted_view(BookList::SortKey::TITLE);
+  const BookList::SortedView by_author =
+      list.sorted_view(BookList::SortKey::AUTHOR);
+  const BookList::SortedView by_isbn = list.sorted_view(BookList::SortKey::ISBN);
+  const BookList::SortedView by_price =
+      list.sorted_view(BookList::SortKey::PRICE);
+
+  CHECK_EQ(3U, by_title.size());
+  CHECK_EQ(std::vector<std::string>({book_2.title(), book_1.title(),
+                                     book_3.title()}),
+           titles(by_title));
+  CHECK_EQ(std::vector<std::string>({book_3.title(), book_2.title(),
+                                     book_1.title()}),
+           titles(by_author));
+  CHECK_EQ(std::vector<std::string>({book_2.title(), book_3.title(),
+                                     book_1.title()}),
+           titles(by_isbn));
+  CHECK_EQ(std::vector<std::string>({book_1.title(), book_2.title(),
+                                     book_3.title()}),
+           titles(by_price));
+
+  SUBCASE("NoCopies") {
+    // Every view hands out references to the same books held by the list.
+    CHECK_EQ(&*by_title.begin(),
+             &*std::next(list.sorted_view(BookList::SortKey::PRICE).begin()));
+    CHECK_EQ(book_2, *by_title.begin());
+    CHECK_EQ(book_3, *std::prev(by_title.end()));
+  }
+
+  SUBCASE("Updates") {
+    list.remove(book_2);
+    list.move_to_top(book_3);
+    list.insert(Book("Pride and Prejudice", "Jane Austen", "4", 5.00), 1U);
+    CHECK_EQ(std::vector<std::string>({"Goodnight Moon", "Pride and Prejudice",
+                                       "The C++ Programming Language"}),
+             titles(by_title));
+    CHECK_EQ(std::vector<std::string>({"Pride and Prejudice", "Goodnight Moon",
+                                       "The C++ Programming Language"}),
+             titles(by_price));
+  }
+
+  SUBCASE("Copies") {
+    BookList copy(list);
+    list.remove(book_1);
+    CHECK_EQ(2U, by_title.size());
+    CHECK_EQ(3U, copy.sorted_view(BookList::SortKey::TITLE).size());
+
+    copy = list;
+    CHECK_EQ(titles(by_title),
+             titles(copy.sorted_view(BookList::SortKey::TITLE)));
+  }
+}
+
+TEST_CASE("ChangeFeed") {
+  const Book book_1("book_1"),
+      book_2("book_2"),
+      book_3("book_3"),
+      book_4("book_4");
+
+  BookList list = {book_1, book_2, book_3};
+
+  // Mirrors the list by replaying each batch on a copy.
+  BookList mirror(list);
+  std::size_t batches = 0;
+  const std::size_t id = list.subscribe(
+      [&](const std::vector<BookList::Change>& changes) {
+        ++batches;
+        for (const BookList::Change& change : changes) {
+          switch (change.kind) {
+            case BookList::Change::Kind::INSERTED: {
+              mirror.insert(change.book, change.offset);
+              break;
+            }
+            case BookList::Change::Kind::REMOVED: {
+              mirror.remove(change.offset);
+              break;
+            }
+            case BookList::Change::Kind::MOVED: {
+              const Book book = mirror.at(change.offset);
+              mirror.remove(change.offset).insert(book, change.to);
+              break;
+            }
+          }
+        }
+      });
+
+  SUBCASE("Batches") {
+    std::vector<BookList::Change> seen;
+    list.subscribe([&](const std::vector<BookList::Change>& changes) {
+      seen = changes;
+    });
+
+    list.insert(book_4, 1U).remove(book_1).move_to_top(book_3);
+    CHECK_EQ(0U, batches);
+    list.flush_changes();
+    CHECK_EQ(1U, batches);
+    CHECK_EQ(list, mirror);
+
+    REQUIRE_EQ(3U, seen.size());
+    CHECK(seen[0].kind == BookList::Change::Kind::INSERTED);
+    CHECK_EQ(1U, seen[0].offset);
+    CHECK_EQ(book_4, seen[0].book);
+    CHECK(seen[1].kind == BookList::Change::Kind::REMOVED);
+    CHECK_EQ(0U, seen[1].offset);
+    CHECK(seen[2].kind == BookList::Change::Kind::MOVED);
+    CHECK_EQ(2U, seen[2].offset);
+    CHECK_EQ(0U, seen[2].to);
+
+    // Nothing changed, so nothing is delivered.
+    list.flush_changes();
+    CHECK_EQ(1U, batches);
+  }
+
+  SUBCASE("SubscribeDuringDelivery") {
+    // A subscriber that unsubscribes itself and a later one, and adds another.
+    std::size_t self = 0, later = 0, later_calls = 0, added_calls = 0;
+    self = list.subscribe([&](const std::vector<BookList::Change>&) {
+      list.unsubscribe(self);
+      list.unsubscribe(later);
+      list.subscribe([&](const std::vector<BookList::Change>&) {
+        ++added_calls;
+      });
+    });
+    later = list.subscribe([&](const std::vector<BookList::Change>&) {
+      ++later_calls;
+    });
+
+    list.remove(book_1);
+    list.flush_changes();
+    CHECK_EQ(1U, batches);
+    CHECK_EQ(0U, later_calls);
+    CHECK_EQ(0U, added_calls);
+
+    list.remove(book_2);
+    list.flush_changes();
+    CHECK_EQ(2U, batches);
+    CHECK_EQ(0U, later_calls);
+    CHECK_EQ(1U, added_calls);
+    CHECK_EQ(list, mirror);
+  }
+
+  SUBCASE("RemoveIf") {
+    list.insert(book_4, BookList::Position::BOTTOM);
+    list.remove_if([&](const Book& book) {
+      return book == book_1 || book == book_3 || book == book_4;
+    });
+    list.flush_changes();
+    CHECK_EQ(BookList({book_2}), mirror);
+  }
+
+  SUBCASE("AssignmentAndSwap") {
+    BookList other = {book_4};
+    list.swap(other);
+    list.flush_changes();
+    CHECK_EQ(list, mirror);
+
+    list = BookList({book_2, book_1});
+    list.flush_changes();
+    CHECK_EQ(list, mirror);
+  }
+
+  SUBCASE("CopiesHaveNoSubscribers") {
+    BookList copy(list);
+    copy.insert(book_4);
+    copy.flush_changes();
+    CHECK_EQ(0U, batches);
+  }
+
+  SUBCASE("Unsubscribe") {
+    list.insert(book_4);
+    list.unsubscribe(id);
+    list.flush_changes();
+    CHECK_EQ(0U, batches);
+  }
+}
+
+TEST_CASE("Merge") {
+  const Book book_1("book_1"),
+      book_2("book_2"),
+      book_3("book_3"),
+      book_4("book_4"),
+      book_5("book_5");
+
+  const BookList store_1 = {book_1, book_2, book_3};
+  const BookList store_2 = {book_4, book_2};
+  const BookList store_3 = {book_3, book_5, book_1};
+  const std::vector<const BookList*> stores = {&store_1, &store_2, &store_3};
+
+  SUBCASE("Concatenate") {
+    BookList chained;
+    for (const BookList* store : stores) {
+      chained += *store;
+    }
+    CHECK_EQ(chained, BookList::merge(stores));
+    CHECK_EQ(BookList({book_1, book_2, book_3, book_4, book_5}),
+             BookList::merge(stores, BookList::MergePolicy::CONCATENATE));
+  }
+
+  SUBCASE("RoundRobin") {
+    CHECK_EQ(BookList({book_1, book_4, book_3, book_2, book_5}),
+             BookList::merge(stores, BookList::MergePolicy::ROUND_ROBIN));
+  }
+
+  SUBCASE("Empty") {
+    CHECK_EQ(BookList(), BookList::merge({}));
+  }
+
+  SUBCASE("Indexed") {
+    const BookList merged = BookList::merge(stores);
+    CHECK_EQ(std::vector<std::string>({"book_1", "book_2"}),
+             merged.titles_with_prefix("book_", 2U));
+  }
+
+  SUBCASE("IndexesEveryList") {
+    const Book moon("Goodnight Moon", "Margaret Wise Brown", "1", 8.99),
+        runaway("The Runaway Bunny", "Margaret Wise Brown", "2", 7.99),
+        language("The C++ Programming Language", "Bjarne Stroustrup", "3",
+                 54.00);
+    const BookList shelf_1 = {moon, book_1};
+    const BookList shelf_2 = {language, moon};
+    const BookList shelf_3 = {runaway};
+    const std::vector<const BookList*> shelves = {&shelf_1, &shelf_2,
+                                                  &shelf_3};
+    const BookList merged =
+        BookList::merge(shelves, BookList::MergePolicy::ROUND_ROBIN);
+    CHECK_EQ(BookList({moon, language, runaway, book_1}), merged);
+
+    CHECK_EQ(std::vector<std::size_t>({0U, 2U}),
+             merged.find_by_author("Margaret Wise Brown"));
+    CHECK_EQ(std::vector<std::string>({"The C++ Programming Language",
+                                       "The Runaway Bunny"}),
+             merged.titles_with_prefix("The ", 10U));
+    CHECK_EQ(std::vector<std::size_t>({1U}), merged.search("programming"));
+    CHECK_EQ(std::vector<Book>({runaway, moon}),
+             merged.books_in_range(1.0, 10.0));
+    CHECK_EQ(54.00, merged.max_price());
+    CHECK_EQ(book_1, *merged.sorted_view(BookList::SortKey::PRICE).begin());
+  }
+}
+
+TEST_CASE("MemoryResource") {
+  const Book book_1("book_1"),
+      book_2("book_2"),
+      book_3("book_3");
+
+  // An arena that fails rather than fall back on the global heap.
+  std::array<std::byte, 65536> buffer;
+  std::pmr::monotonic_buffer_resource arena(
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+  BookList list(&arena);
+  list.insert(book_1).insert(book_2, BookList::Position::BOTTOM);
+  CHECK_EQ(&arena, list.resource());
+  CHECK_EQ(BookList({book_1, book_2}), list);
+
+  SUBCASE("CopyUsesDefaultResource") {
+    const BookList copy(list);
+    CHECK_EQ(std::pmr::get_default_resource(), copy.resource());
+    CHECK_EQ(list, copy);
+  }
+
+  SUBCASE("MoveKeepsResource") {
+    const BookList moved(std::move(list));
+    CHECK_EQ(&arena, moved.resource());
+    CHECK_EQ(BookList({book_1, book_2}), moved);
+  }
+
+  SUBCASE("SwapAcrossResources") {
+    BookList other = {book_3};
+    list.swap(other);
+    CHECK_EQ(&arena, list.resource());
+    CHECK_EQ(BookList({book_3}), list);
+    CHECK_EQ(BookList({book_1, book_2}), other);
+
+    // The sorted views follow the copied books.
+    CHECK_EQ(book_3, *list.sorted_view(BookList::SortKey::TITLE).begin());
+    CHECK_EQ(book_1, *other.sorted_view(BookList::SortKey::TITLE).begin());
+  }
+
+  SUBCASE("IndexesUseResource") {
+    // An index left on the default resource would now throw.
+    std::pmr::memory_resource* previous =
+        std::pmr::set_default_resource(std::pmr::null_memory_resource());
+    CHECK_NOTHROW(list.insert(book_3, BookList::Position::BOTTOM)
+                      .move_to_top(book_3)
+                      .remove(book_1));
+    std::pmr::set_default_resource(previous);
+    CHECK_EQ(std::vector<std::string>{"book_2", "book_3"},
+             list.titles_with_prefix("book_", 10));
+    CHECK_EQ(std::vector<std::size_t>{0}, list.search("book_3"));
+  }
+
+  SUBCASE("ReadIntoArena") {
+    std::stringstream ss("1\n 0:  \"isbn\",\"title\",\"author\",1\n\n");
+    ss >> list;
+    CHECK_EQ(&arena, list.resource());
+    CHECK_EQ(BookList({Book("title", "author", "isbn", 1.0)}), list);
+  }
+}
+
+// Counts the allocations passed on to the default resource.
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+
+  // Allocations beyond this many throw std::bad_alloc.
+  std::size_t limit = static_cast<std::size_t>(-1);
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    if (allocations >= limit) {
+      throw std::bad_alloc();
+    }
+    ++allocations;
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* p, std::size_t bytes,
+                     std::size_t alignment) override {
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const
+      noexcept override {
+    return this == &other;
+  }
+};
+
+TEST_CASE("NodePool") {
+  const Book book_1("book_1"),
+      book_2("book_2"),
+      book_3("book_3"),
+      book_4("book_4");
+
+  CountingResource resource;
+  BookList list(&resource);
+  list.insert(book_1).insert(book_2).insert(book_3).insert(book_4);
+  const std::size_t allocations = resource.allocations;
+
+  // Freed nodes are reused, so churning the list allocates nothing more.
+  for (int i = 0; i < 20; ++i) {
+    list.move_to_top(book_1).move_to_top(book_3);
+    list.remove(book_2).insert(book_2, 2U);
+  }
+  CHECK_EQ(allocations, resource.allocations);
+  CHECK_EQ(BookList({book_3, book_1, book_2, book_4}), list);
+
+  SUBCASE("SwapSameResource") {
+    BookList other(&resource);
+    other.insert(book_4);
+    list.swap(other);
+    CHECK_EQ(BookList({book_4}), list);
+    CHECK_EQ(BookList({book_3, book_1, book_2, book_4}), other);
+    other.remove(book_1);
+    list.insert(book_1);
+    CHECK_EQ(BookList({book_1, book_4}), list);
+    CHECK_EQ(BookList({book_3, book_2, book_4}), other);
+  }
+
+  SUBCASE("FailedSwapChangesNothing") {
+    BookList other = {book_2};
+    resource.limit = resource.allocations;
+    CHECK_THROWS_AS(list.swap(other), std::bad_alloc);
+    resource.limit = static_cast<std::size_t>(-1);
+    CHECK_EQ(BookList({book_3, book_1, book_2, book_4}), list);
+    CHECK_EQ(BookList({book_2}), other);
+    const BookList::SortedView by_title =
+        list.sorted_view(BookList::SortKey::TITLE);
+    CHECK_EQ(book_4, *std::prev(by_title.end()));
+  }
+
+  SUBCASE("MovedFromStaysUsable") {
+    BookList moved(std::move(list));
+    CHECK_EQ(&resource, list.resource());
+    list.insert(book_2);
+    moved.remove(book_2);
+    moved.insert(book_2, BookList::Position::BOTTOM);
+    CHECK_EQ(BookList({book_2}), list);
+    CHECK_EQ(BookList({book_3, book_1, book_4, book_2}), moved);
+  }
+}
+
 TEST_CASE("RelationalOperators") {
   SUBCASE("Comparison") {
     const Book a("a"), b("b");
@@ -265,6 +1092,39 @@ TEST_CASE("StreamExtraction") {
     }));
   }
 
+  SUBCASE("WithTruncatedList") {
+    // A count larger than the books present stages only the books read.
+    std::stringstream ss("4000000000\n 0:  \"123\", \"A\", \"B\", 1\n");
+    BookList list;
+    ss >> list;
+    CHECK_EQ(BookList({Book("A", "B", "123", 1.0)}), list);
+  }
+
+  SUBCASE("WithIsbnPolicy") {
+    const std::string text =
+        "3\n 0:  \"0-06-443017-0\", \"A\", \"B\", 1\n"
+        " 1:  \"bogus\", \"D\", \"E\", 2\n"
+        " 2:  \"9780804429573\", \"G\", \"H\", 3\n\n";
+    BookList list;
+
+    std::stringstream keep(text);
+    CHECK_EQ(0U, list.read(keep, BookList::IsbnPolicy::KEEP));
+    CHECK_EQ(list, BookList({Book("A", "B", "0-06-443017-0", 1.0),
+                             Book("D", "E", "bogus", 2.0),
+                             Book("G", "H", "9780804429573", 3.0)}));
+
+    std::stringstream normalize(text);
+    CHECK_EQ(0U, list.read(normalize, BookList::IsbnPolicy::NORMALIZE));
+    CHECK_EQ(list, BookList({Book("A", "B", "9780064430173", 1.0),
+                             Book("D", "E", "bogus", 2.0),
+                             Book("G", "H", "9780804429573", 3.0)}));
+
+    std::stringstream reject(text);
+    CHECK_EQ(1U, list.read(reject, BookList::IsbnPolicy::REJECT_INVALID));
+    CHECK_EQ(list, BookList({Book("A", "B", "9780064430173", 1.0),
+                             Book("G", "H", "9780804429573", 3.0)}));
+  }
+
   SUBCASE("WithMultipleLists") {
     std::stringstream ss("2\n 0:  \"123\", \"A\", \"B\", 1\n 1:  \"456\", \"D\", \"E\", 2\n\n1\n 2:  \"789\", \"G\", \"H\", 3\n");
     BookList list1, list2;
@@ -0,0 +1,134 @@
+#include "book_list_writer.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <system_error>
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "file_io.hpp"
+
+namespace {
+
+// The width operator<< pads each book's index to.
+constexpr std::size_t index_width = 5;
+
+// The significant digits a stream with default precision prints.
+constexpr int price_precision = 6;
+
+}  // namespace
+
+//
+// Constructors, Assignments, and Destructor
+//
+
+BookListWriter::BookListWriter(std::ostream& stream, std::size_t buffer_size)
+    : stream_(&stream), buffer_size_(buffer_size) {
+  buffer_.reserve(buffer_size_);
+}
+
+BookListWriter::BookListWriter(int fd, std::size_t buffer_size)
+    : fd_(fd), buffer_size_(buffer_size) {
+  buffer_.reserve(buffer_size_);
+}
+
+BookListWriter::~BookListWriter() {
+  // Destructors must not throw, so a failure here is dropped; call flush()
+  // first to see it.
+  try {
+    flush();
+  } catch (const WriteException&) {
+  }
+}
+
+//
+// Writing
+//
+
+BookListWriter& BookListWriter::write(const Book& book) {
+  append_quoted(book.isbn());
+  buffer_ += ',';
+  append_quoted(book.title());
+  buffer_ += ',';
+  append_quoted(book.author());
+  buffer_ += ',';
+
+  // Shortest round trip is not what a stream prints; "%g" with precision 6
+  // is, and to_chars' general format matches it.
+  char digits[64];
+  auto [end, error] = std::to_chars(digits, digits + sizeof digits,
+                                    book.price(), std::chars_format::general,
+                                    price_precision);
+  buffer_.append(digits, end);
+  buffer_ += '\n';
+
+  flush_if_full();
+  return *this;
+}
+
+BookListWriter& BookListWriter::write(const BookList& book_list) {
+  char digits[24];
+  auto [end, error] =
+      std::to_chars(digits, digits + sizeof digits, book_list.size());
+  buffer_.append(digits, end);
+
+  // Iterate rather than call at(), which checks the whole list each time.
+  std::size_t i = 0;
+  for (const Book& book : book_list) {
+    buffer_ += '\n';
+    auto [end, error] = std::to_chars(digits, digits + sizeof digits, i++);
+    const std::size_t length = static_cast<std::size_t>(end - digits);
+    if (length < index_width) {
+      buffer_.append(index_width - length, ' ');
+    }
+    buffer_.append(digits, end);
+    buffer_ += ":  ";
+    write(book);
+  }
+  buffer_ += '\n';
+
+  flush_if_full();
+  return *this;
+}
+
+void BookListWriter::flush() {
+  if (buffer_.empty()) {
+    return;
+  }
+
+  if (stream_ != nullptr) {
+    stream_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!*stream_) {
+      throw WriteException("Cannot write book list to stream");
+    }
+  } else if (!write_all(fd_, buffer_)) {
+    throw WriteException(std::string("Cannot write book list: ")
+                         + std::strerror(errno));
+  }
+  buffer_.clear();
+}
+
+//
+// Helpers
+//
+
+void BookListWriter::append_quoted(const std::string& text) {
+  buffer_ += '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      buffer_ += '\\';
+    }
+    buffer_ += c;
+  }
+  buffer_ += '"';
+}
+
+void BookListWriter::flush_if_full() {
+  if (buffer_.size() >= buffer_size_) {
+    flush();
+  }
+}
\ No newline at end of file
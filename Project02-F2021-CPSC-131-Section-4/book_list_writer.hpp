@@ -0,0 +1,85 @@
+#ifndef _book_list_writer_hpp_
+#define _book_list_writer_hpp_
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// The BookListWriter class writes books and book lists in the same text
+// format as their operator<<, byte for byte, without going through iostream
+// formatting or flushing after every book.
+//
+// Output is formatted into a reusable buffer and handed to the destination
+// in large blocks, either with ostream::write or straight to a file
+// descriptor with write(2). Prices are formatted as a stream with default
+// precision and flags would format them.
+class BookListWriter {
+ public:
+  //
+  // Types and Exceptions
+  //
+
+  // Thrown if the destination rejects a write.
+  struct WriteException : std::runtime_error {
+    using runtime_error::runtime_error;
+  };
+
+  //
+  // Constructors, Assignments, and Destructor
+  //
+
+  // Writes to stream, handing it buffer_size bytes at a time.
+  explicit BookListWriter(std::ostream& stream,
+                          std::size_t buffer_size = 1 << 16);
+
+  // Writes to the open file descriptor fd, which the writer does not close,
+  // buffer_size bytes at a time.
+  explicit BookListWriter(int fd, std::size_t buffer_size = 1 << 16);
+
+  BookListWriter(const BookListWriter& other) = delete;
+
+  BookListWriter& operator=(const BookListWriter& rhs) = delete;
+
+  // The destructor writes out anything still buffered.
+  ~BookListWriter();
+
+  //
+  // Writing
+  //
+
+  // Writes book as `stream << book` would.
+  BookListWriter& write(const Book& book);
+
+  // Writes book_list as `stream << book_list` would.
+  BookListWriter& write(const BookList& book_list);
+
+  // Hands everything buffered to the destination.
+  //
+  // Throws WriteException if the destination rejects it.
+  void flush();
+
+ private:
+  // Appends text to the buffer, quoted and escaped as std::quoted does.
+  void append_quoted(const std::string& text);
+
+  // Flushes the buffer if it has reached its size.
+  void flush_if_full();
+
+  // The stream written to, or nullptr when writing to fd_.
+  std::ostream* stream_ = nullptr;
+
+  // The file descriptor written to when there is no stream.
+  int fd_ = -1;
+
+  // The size at which the buffer is flushed.
+  std::size_t buffer_size_ = 0;
+
+  // The output not yet handed to the destination.
+  std::string buffer_;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+// Unit tests for the BookListWriter class.
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "book_list_writer.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("BookListWriter") {
+  const Book book_1("Programming with C++", "Diane Zak", "9780064430173", 31.99),
+      book_2("Say \"Hi\"", "Back\\Slash", "0", 1e-7),
+      book_3("", "", "", 0.0),
+      book_4("Costly", "", "4", 123456789.0),
+      book_5("Round", "", "5", 100.0);
+
+  SUBCASE("MatchesOperators") {
+    const BookList list = {book_1, book_2, book_3, book_4, book_5};
+    for (std::size_t buffer_size : {1U, 16U, 1U << 16}) {
+      std::ostringstream expected, actual;
+      expected << book_2 << list << BookList();
+      {
+        BookListWriter writer(actual, buffer_size);
+        writer.write(book_2).write(list).write(BookList());
+      }
+      CHECK_EQ(expected.str(), actual.str());
+    }
+  }
+
+  SUBCASE("Appends") {
+    // Each writer carries on from where the previous one left the stream.
+    std::ostringstream expected, actual;
+    for (int i = 0; i < 11; ++i) {
+      const BookList list = {Book("title", "author", std::to_string(i), i)};
+      expected << list;
+      BookListWriter(actual).write(list);
+    }
+    CHECK_EQ(expected.str(), actual.str());
+  }
+
+  SUBCASE("FileDescriptor") {
+    const std::string path =
+        std::filesystem::temp_directory_path().string()
+        + "/book_list_writer_test.txt";
+    const BookList list = {book_1, book_2};
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    REQUIRE(fd >= 0);
+    {
+      BookListWriter writer(fd, 8U);
+      writer.write(list);
+      writer.flush();
+    }
+    ::close(fd);
+
+    std::ifstream file(path);
+    const std::string written((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+    std::ostringstream expected;
+    expected << list;
+    CHECK_EQ(expected.str(), written);
+    std::remove(path.c_str());
+
+    BookListWriter closed(-1);
+    closed.write(book_1);
+    CHECK_THROWS_AS(closed.flush(), BookListWriter::WriteException);
+  }
+}
\ No newline at end of file
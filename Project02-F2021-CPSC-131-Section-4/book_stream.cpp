@@ -0,0 +1,44 @@
+#include "book_stream.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "book.hpp"
+#include "generator.hpp"
+
+Generator<const Book&> book_stream(std::istream& stream) {
+  std::size_t count = 0;
+  if (!(stream >> count)) {
+    co_return;
+  }
+
+  // Read each label and book as BookList's operator>> does, into the one
+  // book and label reused throughout.
+  std::string label_holder;
+  Book book;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!(stream >> label_holder >> book)) {
+      co_return;
+    }
+    co_yield book;
+  }
+}
+
+Generator<const Book&> book_stream(std::string path, std::size_t buffer_size) {
+  // The buffer must be installed before the file is opened to take effect.
+  std::vector<char> buffer(buffer_size);
+  std::ifstream file;
+  file.rdbuf()->pubsetbuf(buffer.data(),
+                          static_cast<std::streamsize>(buffer.size()));
+  file.open(path);
+  if (!file) {
+    throw BookStreamException("Cannot open book file " + path);
+  }
+
+  for (const Book& book : book_stream(file)) {
+    co_yield book;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef _book_stream_hpp_
+#define _book_stream_hpp_
+
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "book.hpp"
+#include "generator.hpp"
+
+// Lazy reading of the books in a file written by a BookList's operator<<,
+// for jobs that scan a catalog once and have no need for a BookList.
+//
+// Books are yielded one at a time in file order, without removing
+// duplicates, and each refers to a single Book reused for the whole file: it
+// is valid only until the generator is advanced, so copy it to keep it. The
+// sequence ends early if the file is cut short or malformed.
+
+// Thrown, when reading begins, if the file cannot be opened.
+struct BookStreamException : std::runtime_error {
+  using runtime_error::runtime_error;
+};
+
+// Yields the books read from stream, which must outlive the generator.
+Generator<const Book&> book_stream(std::istream& stream);
+
+// Yields the books in the file at path, reading it in blocks of buffer_size
+// bytes.
+Generator<const Book&> book_stream(std::string path,
+                                   std::size_t buffer_size = 1 << 16);
+
+#endif
\ No newline at end of file
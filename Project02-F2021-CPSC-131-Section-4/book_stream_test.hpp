@@ -0,0 +1,78 @@
+// Unit tests for the book_stream generators.
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "book_stream.hpp"
+#include "doctest.hpp"
+#include "generator.hpp"
+
+static_assert(std::ranges::input_range<Generator<const Book&>>);
+static_assert(std::ranges::view<Generator<const Book&>>);
+
+TEST_CASE("BookStream") {
+  const Book book_1("Programming with C++", "Diane Zak", "9780064430173", 31.99),
+      book_2("Goodnight Moon", "Margaret Wise Brown", "9780064430180", 8.99),
+      book_3("Programming with Java", "Diane Zak", "9780064430197", 29.99);
+  const BookList list = {book_1, book_2, book_3};
+
+  SUBCASE("Stream") {
+    std::stringstream stream;
+    stream << list;
+    std::vector<Book> books;
+    for (const Book& book : book_stream(stream)) {
+      books.push_back(book);
+    }
+    CHECK_EQ(std::vector<Book>({book_1, book_2, book_3}), books);
+  }
+
+  SUBCASE("Filter") {
+    std::stringstream stream;
+    stream << list;
+    std::vector<std::string> titles;
+    for (const Book& book : book_stream(stream)
+                                | std::views::filter([](const Book& book) {
+                                    return book.author() == "Diane Zak";
+                                  })
+                                | std::views::take(1)) {
+      titles.push_back(book.title());
+    }
+    CHECK_EQ(std::vector<std::string>({"Programming with C++"}), titles);
+  }
+
+  SUBCASE("Truncated") {
+    std::stringstream full;
+    full << list;
+    std::istringstream stream(full.str().substr(0, full.str().size() / 2));
+    std::size_t count = 0;
+    for (const Book& book : book_stream(stream)) {
+      CHECK_EQ(list.at(count++), book);
+    }
+    CHECK_EQ(1U, count);
+  }
+
+  SUBCASE("File") {
+    const std::string path = std::filesystem::temp_directory_path().string()
+                             + "/book_stream_test.txt";
+    {
+      std::ofstream file(path);
+      file << list;
+    }
+    std::vector<Book> books;
+    for (const Book& book : book_stream(path, 16U)) {
+      books.push_back(book);
+    }
+    CHECK_EQ(std::vector<Book>({book_1, book_2, book_3}), books);
+    std::remove(path.c_str());
+
+    auto missing = book_stream(path);
+    CHECK_THROWS_AS(missing.begin(), BookStreamException);
+  }
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <sstream>
 #include <string>
+#include <unordered_set>
 
 #include "book.hpp"
 #include "doctest.hpp"
@@ -279,4 +280,12 @@ TEST_CASE("StreamExtraction") {
     CHECK_EQ("H", c.author());
     CHECK_EQ(3, c.price());
   }
+}
+
+TEST_CASE("Hashing") {
+  const std::unordered_set<Book> books = {
+      Book("a", "b", "c", 1.0), Book("a", "b", "c", 2.0), Book("a", "b", "c", 1.0)};
+  CHECK_EQ(2U, books.size());
+  CHECK_EQ(std::hash<Book>()(Book("a", "b", "c", 1.0)),
+           std::hash<Book>()(Book("a", "b", "c", 1.0)));
 }
\ No newline at end of file
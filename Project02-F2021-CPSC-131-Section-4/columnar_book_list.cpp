@@ -0,0 +1,146 @@
+#include "columnar_book_list.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+//
+// Book Views
+//
+
+Book ColumnarBookList::BookView::to_book() const {
+  return Book(std::string(title), std::string(author), std::string(isbn),
+              price);
+}
+
+//
+// Constructors, Assignments, and Destructor
+//
+
+ColumnarBookList::ColumnarBookList(const BookList& book_list) {
+  const std::size_t size = book_list.size();
+  isbn_ends_.reserve(size);
+  title_ends_.reserve(size);
+  author_ids_.reserve(size);
+  prices_.reserve(size);
+  fingerprints_.reserve(size);
+
+  // A book list holds no duplicates, so its books go straight into the
+  // columns without push_back()'s find().
+  for (const Book& book : book_list) {
+    append_unchecked(book);
+  }
+}
+
+//
+// Queries
+//
+
+std::size_t ColumnarBookList::size() const {
+  return prices_.size();
+}
+
+ColumnarBookList::BookView ColumnarBookList::view(
+    std::size_t offset_from_top) const {
+  if (offset_from_top >= size()) {
+    throw InvalidOffsetException(
+        "Offset beyond end of current list size in view");
+  }
+  return {entry(isbn_chars_, isbn_ends_, offset_from_top),
+          entry(title_chars_, title_ends_, offset_from_top),
+          authors_[author_ids_[offset_from_top]],
+          prices_[offset_from_top]};
+}
+
+Book ColumnarBookList::at(std::size_t offset_from_top) const {
+  return view(offset_from_top).to_book();
+}
+
+std::size_t ColumnarBookList::find(const Book& book) const {
+  // Scan the fingerprints, confirming only the rows that collide.
+  const std::size_t fingerprint = std::hash<Book>()(book);
+  for (std::size_t i = 0; i < fingerprints_.size(); ++i) {
+    if (fingerprints_[i] != fingerprint) {
+      continue;
+    }
+    const BookView candidate = view(i);
+    if (candidate.price == book.price() && candidate.isbn == book.isbn()
+        && candidate.title == book.title()
+        && candidate.author == book.author()) {
+      return i;
+    }
+  }
+  return size();
+}
+
+std::size_t ColumnarBookList::find_isbn(std::string_view isbn) const {
+  for (std::size_t i = 0; i < isbn_ends_.size(); ++i) {
+    if (entry(isbn_chars_, isbn_ends_, i) == isbn) {
+      return i;
+    }
+  }
+  return size();
+}
+
+std::vector<std::size_t> ColumnarBookList::priced_between(double lo,
+                                                          double hi) const {
+  std::vector<std::size_t> offsets;
+  for (std::size_t i = 0; i < prices_.size(); ++i) {
+    if (prices_[i] >= lo && prices_[i] <= hi) {
+      offsets.push_back(i);
+    }
+  }
+  return offsets;
+}
+
+std::span<const double> ColumnarBookList::prices() const {
+  return prices_;
+}
+
+//
+// Mutators
+//
+
+ColumnarBookList& ColumnarBookList::push_back(const Book& book) {
+  // Prevent duplicate entries.
+  if (find(book) == size()) {
+    append_unchecked(book);
+  }
+  return *this;
+}
+
+//
+// Helpers
+//
+
+void ColumnarBookList::append_unchecked(const Book& book) {
+  isbn_chars_ += book.isbn();
+  isbn_ends_.push_back(static_cast<std::uint32_t>(isbn_chars_.size()));
+
+  title_chars_ += book.title();
+  title_ends_.push_back(static_cast<std::uint32_t>(title_chars_.size()));
+
+  auto [author, added] = author_ids_by_name_.try_emplace(
+      book.author(), static_cast<std::uint32_t>(authors_.size()));
+  if (added) {
+    authors_.push_back(book.author());
+  }
+  author_ids_.push_back(author->second);
+
+  prices_.push_back(book.price());
+  fingerprints_.push_back(std::hash<Book>()(book));
+}
+
+std::string_view ColumnarBookList::entry(const std::string& chars,
+                                         const std::vector<std::uint32_t>& ends,
+                                         std::size_t offset_from_top) {
+  const std::size_t begin = offset_from_top == 0 ? 0 : ends[offset_from_top - 1];
+  return std::string_view(chars).substr(begin, ends[offset_from_top] - begin);
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef _columnar_book_list_hpp_
+#define _columnar_book_list_hpp_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// The ColumnarBookList class stores books column by column rather than as
+// Book objects, so a scan over one field reads only that field's bytes.
+//
+// ISBNs and titles are packed end to end in character columns, authors are
+// ids into a dictionary of distinct names, prices are a plain column, and
+// each book's hash is kept as a fingerprint for fast equality scans. Like a
+// BookList, it ignores books it already holds.
+class ColumnarBookList {
+ public:
+  //
+  // Types and Exceptions
+  //
+
+  // Thrown if a book is requested beyond the end of the list.
+  struct InvalidOffsetException : std::logic_error {
+    using logic_error::logic_error;
+  };
+
+  // A view of one book's fields, valid until the list is next changed.
+  struct BookView {
+    std::string_view isbn;
+    std::string_view title;
+    std::string_view author;
+    double price;
+
+    // Returns the book the view describes.
+    Book to_book() const;
+  };
+
+  //
+  // Constructors, Assignments, and Destructor
+  //
+
+  // This constructor constructs an empty columnar book list.
+  ColumnarBookList() = default;
+
+  // This constructor copies the books of book_list, keeping their order.
+  explicit ColumnarBookList(const BookList& book_list);
+
+  //
+  // Queries
+  //
+
+  // Returns the number of books in this book list.
+  std::size_t size() const;
+
+  // Returns a view of the book at the (zero-based) offset from the top.
+  //
+  // Throws InvalidOffsetException if the offset is not less than size().
+  BookView view(std::size_t offset_from_top) const;
+
+  // Returns a copy of the book at the (zero-based) offset from the top.
+  //
+  // Throws InvalidOffsetException if the offset is not less than size().
+  Book at(std::size_t offset_from_top) const;
+
+  // Returns the (zero-based) offset from the top of the list for book.
+  //
+  // If the book is not in the list, returns size().
+  std::size_t find(const Book& book) const;
+
+  // Returns the offset of the first book with isbn, or size() if none has.
+  std::size_t find_isbn(std::string_view isbn) const;
+
+  // Returns the offsets, in list order, of the books priced from lo to hi,
+  // inclusive.
+  std::vector<std::size_t> priced_between(double lo, double hi) const;
+
+  // Returns the price column.
+  std::span<const double> prices() const;
+
+  //
+  // Mutators
+  //
+
+  // Adds the book to the bottom of the list.
+  //
+  // If the book is already in the list, the method does nothing.
+  ColumnarBookList& push_back(const Book& book);
+
+ private:
+  // Appends book to every column without checking for duplicates.
+  void append_unchecked(const Book& book);
+
+  // Returns the text of entry offset_from_top in a packed column.
+  static std::string_view entry(const std::string& chars,
+                                const std::vector<std::uint32_t>& ends,
+                                std::size_t offset_from_top);
+
+  // The ISBNs, end to end, and the position just past each.
+  std::string isbn_chars_;
+  std::vector<std::uint32_t> isbn_ends_;
+
+  // The titles, end to end, and the position just past each.
+  std::string title_chars_;
+  std::vector<std::uint32_t> title_ends_;
+
+  // The distinct authors in order of first appearance, the id of each, and
+  // each book's author id.
+  std::vector<std::string> authors_;
+  std::unordered_map<std::string, std::uint32_t> author_ids_by_name_;
+  std::vector<std::uint32_t> author_ids_;
+
+  // Each book's price.
+  std::vector<double> prices_;
+
+  // Each book's std::hash<Book>.
+  std::vector<std::size_t> fingerprints_;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+// Unit tests for the ColumnarBookList class.
+
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "columnar_book_list.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("ColumnarBookList") {
+  const Book book_1("Programming with C++", "Diane Zak", "9780064430173", 31.99),
+      book_2("Goodnight Moon", "Margaret Wise Brown", "9780064430180", 8.99),
+      book_3("Programming with Java", "Diane Zak", "9780064430197", 29.99),
+      book_4("", "", "", 0.0);
+
+  const BookList list = {book_1, book_2, book_3, book_4};
+  ColumnarBookList columns(list);
+
+  SUBCASE("Rows") {
+    REQUIRE_EQ(list.size(), columns.size());
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      CHECK_EQ(list.at(i), columns.at(i));
+    }
+    const ColumnarBookList::BookView view = columns.view(1U);
+    CHECK_EQ("9780064430180", view.isbn);
+    CHECK_EQ("Goodnight Moon", view.title);
+    CHECK_EQ("Margaret Wise Brown", view.author);
+    CHECK_EQ(8.99, view.price);
+    CHECK_THROWS_AS(columns.view(4U), ColumnarBookList::InvalidOffsetException);
+  }
+
+  SUBCASE("Scans") {
+    CHECK_EQ(2U, columns.find(book_3));
+    CHECK_EQ(4U, columns.find(Book("Goodnight Moon")));
+    CHECK_EQ(1U, columns.find_isbn("9780064430180"));
+    CHECK_EQ(4U, columns.find_isbn("978"));
+    CHECK_EQ(std::vector<std::size_t>({1U, 3U}),
+             columns.priced_between(0.0, 10.0));
+    CHECK_EQ(4U, columns.prices().size());
+    CHECK_EQ(29.99, columns.prices()[2]);
+  }
+
+  SUBCASE("PushBack") {
+    columns.push_back(book_2);
+    CHECK_EQ(4U, columns.size());
+    const Book book_5("The Runaway Bunny", "Margaret Wise Brown", "5", 7.99);
+    columns.push_back(book_5);
+    CHECK_EQ(5U, columns.size());
+    CHECK_EQ(book_5, columns.at(4U));
+  }
+}
\ No newline at end of file
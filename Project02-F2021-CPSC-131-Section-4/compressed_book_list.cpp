@@ -0,0 +1,174 @@
+#include "compressed_book_list.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+namespace {
+
+// Appends value to bytes as a varint.
+void put_varint(std::string& bytes, std::size_t value) {
+  while (value >= 0x80) {
+    bytes += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  bytes += static_cast<char>(value);
+}
+
+// Reads the varint at position in bytes, advancing position past it.
+std::size_t get_varint(const std::string& bytes, std::size_t& position) {
+  std::size_t value = 0;
+  for (int shift = 0;; shift += 7) {
+    const auto byte = static_cast<unsigned char>(bytes[position++]);
+    value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+}
+
+// Returns the bytes held by text, counting its heap buffer only when it is
+// too long for the small-string buffer.
+std::size_t string_bytes(const std::string& text) {
+  static const std::size_t inline_capacity = std::string().capacity();
+  return text.size() > inline_capacity ? text.size() + 1 : 0;
+}
+
+}  // namespace
+
+//
+// Constructors, Assignments, and Destructor
+//
+
+CompressedBookList::CompressedBookList(const BookList& book_list) {
+  // Build the author dictionary first so ids follow sorted order. Both
+  // passes iterate the list, since at() checks the whole list each time.
+  for (const Book& book : book_list) {
+    authors_.push_back(book.author());
+  }
+  std::sort(authors_.begin(), authors_.end());
+  authors_.erase(std::unique(authors_.begin(), authors_.end()), authors_.end());
+
+  std::string previous_isbn;
+  std::size_t i = 0;
+  for (const Book& book : book_list) {
+    // Front code the ISBN against its predecessor in the block.
+    const std::string& isbn = book.isbn();
+    std::size_t shared = 0;
+    if (i % kIsbnBlockSize == 0) {
+      isbn_blocks_.push_back(isbns_.size());
+    } else {
+      shared = std::mismatch(isbn.begin(),
+                             isbn.begin() + std::min(isbn.size(),
+                                                     previous_isbn.size()),
+                             previous_isbn.begin())
+                   .first
+          - isbn.begin();
+    }
+    put_varint(isbns_, shared);
+    put_varint(isbns_, isbn.size() - shared);
+    isbns_.append(isbn, shared, std::string::npos);
+    previous_isbn = isbn;
+
+    titles_ += book.title();
+    title_ends_.push_back(static_cast<std::uint32_t>(titles_.size()));
+
+    author_ids_.push_back(static_cast<std::uint32_t>(
+        std::lower_bound(authors_.begin(), authors_.end(), book.author())
+        - authors_.begin()));
+
+    prices_.push_back(book.price());
+
+    uncompressed_bytes_ += sizeof(Book) + string_bytes(book.isbn())
+        + string_bytes(book.title()) + string_bytes(book.author());
+    ++i;
+  }
+}
+
+//
+// Queries
+//
+
+std::size_t CompressedBookList::size() const {
+  return prices_.size();
+}
+
+Book CompressedBookList::at(std::size_t offset_from_top) const {
+  if (offset_from_top >= size()) {
+    throw InvalidOffsetException(
+        "Offset beyond end of current list size in at");
+  }
+
+  const std::size_t title_begin =
+      offset_from_top == 0 ? 0 : title_ends_[offset_from_top - 1];
+  return Book(titles_.substr(title_begin,
+                             title_ends_[offset_from_top] - title_begin),
+              authors_[author_ids_[offset_from_top]],
+              isbn_at(offset_from_top),
+              prices_[offset_from_top]);
+}
+
+std::size_t CompressedBookList::find(const Book& book) const {
+  // A book whose author is not in the dictionary cannot be present.
+  auto author = std::lower_bound(authors_.begin(), authors_.end(),
+                                 book.author());
+  if (author == authors_.end() || *author != book.author()) {
+    return size();
+  }
+  const auto author_id = static_cast<std::uint32_t>(author - authors_.begin());
+
+  // Compare the cheap columns before decoding the ISBN.
+  for (std::size_t i = 0; i < size(); ++i) {
+    if (author_ids_[i] != author_id || prices_[i] != book.price()) {
+      continue;
+    }
+    const std::size_t title_begin = i == 0 ? 0 : title_ends_[i - 1];
+    if (titles_.compare(title_begin, title_ends_[i] - title_begin,
+                        book.title()) == 0
+        && isbn_at(i) == book.isbn()) {
+      return i;
+    }
+  }
+  return size();
+}
+
+std::size_t CompressedBookList::compressed_bytes() const {
+  std::size_t bytes = sizeof(*this) + isbns_.capacity()
+      + isbn_blocks_.capacity() * sizeof(std::size_t) + titles_.capacity()
+      + title_ends_.capacity() * sizeof(std::uint32_t)
+      + authors_.capacity() * sizeof(std::string)
+      + author_ids_.capacity() * sizeof(std::uint32_t)
+      + prices_.capacity() * sizeof(double);
+  for (const std::string& author : authors_) {
+    bytes += string_bytes(author);
+  }
+  return bytes;
+}
+
+std::size_t CompressedBookList::uncompressed_bytes() const {
+  return uncompressed_bytes_;
+}
+
+//
+// Helpers
+//
+
+std::string CompressedBookList::isbn_at(std::size_t offset_from_top) const {
+  // Decode forward from the start of the block.
+  std::size_t position = isbn_blocks_[offset_from_top / kIsbnBlockSize];
+  std::string isbn;
+  for (std::size_t i = offset_from_top / kIsbnBlockSize * kIsbnBlockSize;
+       i <= offset_from_top; ++i) {
+    const std::size_t shared = get_varint(isbns_, position);
+    const std::size_t rest = get_varint(isbns_, position);
+    isbn.resize(shared);
+    isbn.append(isbns_, position, rest);
+    position += rest;
+  }
+  return isbn;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef _compressed_book_list_hpp_
+#define _compressed_book_list_hpp_
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "book.hpp"
+#include "book_list.hpp"
+
+// The CompressedBookList class is a compact, read-only copy of a book list
+// for catalogs that are rarely changed.
+//
+// Rather than four heap strings per book, ISBNs are front coded in blocks,
+// authors are replaced by ids into a dictionary of distinct names, and titles
+// are packed end to end in one buffer. Books are decoded on demand.
+class CompressedBookList {
+ public:
+  //
+  // Types and Exceptions
+  //
+
+  // Thrown if a book is requested beyond the end of the list.
+  struct InvalidOffsetException : std::logic_error {
+    using logic_error::logic_error;
+  };
+
+  //
+  // Constructors, Assignments, and Destructor
+  //
+
+  // This constructor constructs an empty compressed book list.
+  CompressedBookList() = default;
+
+  // This constructor compresses the books of book_list, keeping their order.
+  explicit CompressedBookList(const BookList& book_list);
+
+  //
+  // Queries
+  //
+
+  // Returns the number of books in this book list.
+  std::size_t size() const;
+
+  // Returns the book at the (zero-based) offset from the top of the list.
+  //
+  // Throws InvalidOffsetException if the offset is not less than size().
+  Book at(std::size_t offset_from_top) const;
+
+  // Returns the (zero-based) offset from the top of the list for book.
+  //
+  // If the book is not in the list, returns size().
+  std::size_t find(const Book& book) const;
+
+  // Returns the number of bytes held by the compressed representation.
+  std::size_t compressed_bytes() const;
+
+  // Returns the number of bytes the same books would hold as Book objects.
+  std::size_t uncompressed_bytes() const;
+
+ private:
+  // The number of ISBNs front coded against each other before restarting
+  // with a complete ISBN.
+  static constexpr std::size_t kIsbnBlockSize = 16;
+
+  // Returns the ISBN at offset_from_top.
+  std::string isbn_at(std::size_t offset_from_top) const;
+
+  // The front-coded ISBNs. Each entry is the varint length of the prefix it
+  // shares with the previous ISBN in its block, the varint length of the
+  // rest, and then the rest.
+  std::string isbns_;
+
+  // The position in isbns_ where each block of ISBNs starts.
+  std::vector<std::size_t> isbn_blocks_;
+
+  // The titles, end to end.
+  std::string titles_;
+
+  // The position in titles_ just past each title.
+  std::vector<std::uint32_t> title_ends_;
+
+  // The distinct authors, sorted.
+  std::vector<std::string> authors_;
+
+  // Each book's index into authors_.
+  std::vector<std::uint32_t> author_ids_;
+
+  // Each book's price.
+  std::vector<double> prices_;
+
+  // The bytes the books would hold uncompressed.
+  std::size_t uncompressed_bytes_ = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,46 @@
+// Unit tests for the CompressedBookList class.
+
+#include "book.hpp"
+#include "book_list.hpp"
+#include "compressed_book_list.hpp"
+#include "doctest.hpp"
+
+TEST_CASE("CompressedBookList") {
+  const BookList list = {
+      Book("Programming with C++", "Diane Zak", "9780064430173", 31.99),
+      Book("Goodnight Moon", "Margaret Wise Brown", "9780064430180", 8.99),
+      Book("Programming with Java", "Diane Zak", "9780064430197", 29.99),
+      Book("The Runaway Bunny", "Margaret Wise Brown", "979010181X", 7.99),
+      Book("", "", "", 0.0)};
+
+  const CompressedBookList compressed(list);
+
+  SUBCASE("RoundTrip") {
+    REQUIRE_EQ(list.size(), compressed.size());
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      CHECK_EQ(list.at(i), compressed.at(i));
+    }
+    CHECK_THROWS_AS(compressed.at(5U),
+                    CompressedBookList::InvalidOffsetException);
+  }
+
+  SUBCASE("Find") {
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      CHECK_EQ(i, compressed.find(list.at(i)));
+    }
+    CHECK_EQ(5U, compressed.find(Book("Goodnight Moon", "Margaret Wise Brown",
+                                      "9780064430180", 9.99)));
+    CHECK_EQ(5U, compressed.find(Book("Goodnight Moon", "Nobody")));
+  }
+
+  SUBCASE("Empty") {
+    const CompressedBookList empty{BookList()};
+    CHECK_EQ(0U, empty.size());
+    CHECK_EQ(0U, empty.find(Book()));
+  }
+
+  SUBCASE("Sizes") {
+    CHECK_GT(compressed.uncompressed_bytes(), 0U);
+    CHECK_GT(compressed.compressed_bytes(), 0U);
+  }
+}
\ No newline at end of file
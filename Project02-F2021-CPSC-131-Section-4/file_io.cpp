@@ -0,0 +1,24 @@
+#include "file_io.hpp"
+
+#include <cerrno>
+#include <cstddef>
+#include <string_view>
+
+#include <unistd.h>
+
+bool write_all(int fd, std::string_view bytes) {
+  const char* next = bytes.data();
+  std::size_t remaining = bytes.size();
+  while (remaining > 0) {
+    const ssize_t written = ::write(fd, next, remaining);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    next += written;
+    remaining -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#ifndef _file_io_hpp_
+#define _file_io_hpp_
+
+#include <string_view>
+
+// Functions for writing to file descriptors with write(2).
+
+// Writes all of bytes to the open file descriptor fd, retrying short and
+// interrupted writes. Returns false, leaving errno set, if a write fails.
+bool write_all(int fd, std::string_view bytes);
+
+#endif
\ No newline at end of file
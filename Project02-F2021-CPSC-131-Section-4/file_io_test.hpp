@@ -0,0 +1,35 @@
+// Unit tests for the file descriptor helpers.
+
+#include <cerrno>
+#include <string>
+
+#include <unistd.h>
+
+#include "doctest.hpp"
+#include "file_io.hpp"
+
+TEST_CASE("WriteAll") {
+  SUBCASE("WritesEverything") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    const std::string bytes(1000, 'x');
+    CHECK(write_all(fds[1], bytes));
+    CHECK(write_all(fds[1], ""));
+    ::close(fds[1]);
+
+    std::string read_back;
+    char chunk[256];
+    ssize_t count;
+    while ((count = ::read(fds[0], chunk, sizeof chunk)) > 0) {
+      read_back.append(chunk, static_cast<std::size_t>(count));
+    }
+    ::close(fds[0]);
+    CHECK_EQ(bytes, read_back);
+  }
+
+  SUBCASE("ReportsFailure") {
+    errno = 0;
+    CHECK_FALSE(write_all(-1, "x"));
+    CHECK_EQ(EBADF, errno);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#ifndef _generator_hpp_
+#define _generator_hpp_
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+// The Generator class template is a lazily evaluated sequence produced by a
+// coroutine that co_yields each element in turn. The coroutine runs only as
+// far as the next element each time the iterator is advanced.
+//
+// A Generator is a move-only input view, so standard range adaptors such as
+// std::views::filter and std::views::take compose with it. Reference is the
+// type each element is seen as; a reference type lets the coroutine hand out
+// an object it reuses, valid until the iterator is next advanced.
+template <typename Reference>
+class Generator : public std::ranges::view_base {
+ public:
+  using value_type = std::remove_cvref_t<Reference>;
+
+  class promise_type {
+   public:
+    Generator get_return_object() {
+      return Generator(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    std::suspend_always final_suspend() const noexcept { return {}; }
+
+    // Keeps the address of the yielded element, which lives in the
+    // coroutine's frame until it resumes.
+    std::suspend_always yield_value(
+        std::remove_reference_t<Reference>& value) noexcept {
+      value_ = std::addressof(value);
+      return {};
+    }
+
+    // Copies a temporary into the promise, since it would not outlive the
+    // suspension otherwise.
+    std::suspend_always yield_value(
+        std::remove_reference_t<Reference>&& value) noexcept(
+        std::is_nothrow_move_constructible_v<value_type>) {
+      copy_.emplace(std::move(value));
+      value_ = std::addressof(*copy_);
+      return {};
+    }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept {
+      exception_ = std::current_exception();
+    }
+
+    // Rethrows anything the coroutine threw.
+    void rethrow_if_failed() const {
+      if (exception_) {
+        std::rethrow_exception(exception_);
+      }
+    }
+
+    Reference value() const noexcept {
+      return static_cast<Reference>(*value_);
+    }
+
+   private:
+    std::remove_reference_t<Reference>* value_ = nullptr;
+    std::optional<value_type> copy_;
+    std::exception_ptr exception_;
+  };
+
+  class iterator {
+   public:
+    using value_type = Generator::value_type;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    Reference operator*() const noexcept {
+      return coroutine_.promise().value();
+    }
+
+    iterator& operator++() {
+      coroutine_.resume();
+      if (coroutine_.done()) {
+        coroutine_.promise().rethrow_if_failed();
+      }
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator& it, std::default_sentinel_t) {
+      return it.coroutine_.done();
+    }
+
+   private:
+    friend Generator;
+
+    explicit iterator(std::coroutine_handle<promise_type> coroutine)
+        : coroutine_(coroutine) {}
+
+    std::coroutine_handle<promise_type> coroutine_;
+  };
+
+  Generator(const Generator& other) = delete;
+
+  Generator(Generator&& other) noexcept
+      : coroutine_(std::exchange(other.coroutine_, nullptr)) {}
+
+  Generator& operator=(const Generator& rhs) = delete;
+
+  Generator& operator=(Generator&& rhs) noexcept {
+    Generator moved(std::move(rhs));
+    std::swap(coroutine_, moved.coroutine_);
+    return *this;
+  }
+
+  ~Generator() {
+    if (coroutine_) {
+      coroutine_.destroy();
+    }
+  }
+
+  // Runs the coroutine to its first element. May be called only once.
+  iterator begin() {
+    iterator it(coroutine_);
+    ++it;
+    return it;
+  }
+
+  std::default_sentinel_t end() const noexcept { return {}; }
+
+ private:
+  explicit Generator(std::coroutine_handle<promise_type> coroutine)
+      : coroutine_(coroutine) {}
+
+  std::coroutine_handle<promise_type> coroutine_;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "isbn.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Removes separators from isbn and rewrites it in normalised form without
+// allocating. Returns false, leaving isbn stripped, if it is not valid.
+bool normalize_in_place(std::string& isbn) {
+  // Compact the digits to the front, dropping separators.
+  std::size_t length = 0;
+  for (char c : isbn) {
+    if (c != '-' && c != ' ') {
+      isbn[length++] = c;
+    }
+  }
+  isbn.resize(length);
+
+  if (length == 13) {
+    // Weights alternate 1, 3, 1, ... and the total must be a multiple of 10.
+    unsigned sum = 0;
+    for (std::size_t i = 0; i < 13; ++i) {
+      const unsigned digit = static_cast<unsigned char>(isbn[i]) - '0';
+      if (digit > 9) {
+        return false;
+      }
+      sum += digit * (i % 2 == 0 ? 1 : 3);
+    }
+    return sum % 10 == 0;
+  }
+
+  if (length == 10) {
+    // Weights run 10 down to 1 and the total must be a multiple of 11. The
+    // check digit may be 'X', standing for 10.
+    unsigned sum = 0;
+    unsigned sum13 = 0;
+    for (std::size_t i = 0; i < 9; ++i) {
+      const unsigned digit = static_cast<unsigned char>(isbn[i]) - '0';
+      if (digit > 9) {
+        return false;
+      }
+      sum += digit * (10 - i);
+      // The ISBN-13 places these digits after the "978" prefix, so they take
+      // the weights 3, 1, 3, ...
+      sum13 += digit * (i % 2 == 0 ? 3 : 1);
+    }
+    const char last = isbn[9];
+    if (last == 'X' || last == 'x') {
+      sum += 10;
+    } else if (last >= '0' && last <= '9') {
+      sum += last - '0';
+    } else {
+      return false;
+    }
+    if (sum % 11 != 0) {
+      return false;
+    }
+
+    // 9*1 + 7*3 + 8*1 = 38 for the "978" prefix.
+    const unsigned check = (10 - (38 + sum13) % 10) % 10;
+    isbn.resize(13);
+    for (std::size_t i = 9; i-- > 0;) {
+      isbn[i + 3] = isbn[i];
+    }
+    isbn[0] = '9';
+    isbn[1] = '7';
+    isbn[2] = '8';
+    isbn[12] = static_cast<char>('0' + check);
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+std::string strip_isbn_separators(const std::string& isbn) {
+  std::string stripped;
+  stripped.reserve(isbn.size());
+  for (char c : isbn) {
+    if (c != '-' && c != ' ') {
+      stripped += c;
+    }
+  }
+  return stripped;
+}
+
+bool is_valid_isbn10(const std::string& isbn) {
+  std::string stripped = strip_isbn_separators(isbn);
+  return stripped.size() == 10 && normalize_in_place(stripped);
+}
+
+bool is_valid_isbn13(const std::string& isbn) {
+  std::string stripped = strip_isbn_separators(isbn);
+  return stripped.size() == 13 && normalize_in_place(stripped);
+}
+
+bool is_valid_isbn(const std::string& isbn) {
+  std::string normalized(isbn);
+  return normalize_in_place(normalized);
+}
+
+std::string isbn10_to_isbn13(const std::string& isbn) {
+  if (!is_valid_isbn10(isbn)) {
+    throw InvalidIsbnException("Invalid ISBN-10 in isbn10_to_isbn13: " + isbn);
+  }
+  return normalize_isbn(isbn);
+}
+
+std::string normalize_isbn(const std::string& isbn) {
+  std::string normalized(isbn);
+  if (!normalize_in_place(normalized)) {
+    throw InvalidIsbnException("Invalid ISBN in normalize_isbn: " + isbn);
+  }
+  return normalized;
+}
+
+std::size_t normalize_isbns(std::vector<std::string>& isbns) {
+  std::size_t rejected = 0;
+  for (std::string& isbn : isbns) {
+    if (!normalize_in_place(isbn)) {
+      isbn.clear();
+      ++rejected;
+    }
+  }
+  return rejected;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef _isbn_hpp_
+#define _isbn_hpp_
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Functions for validating and normalising international standard book
+// numbers. A normalised ISBN is the 13 digit form with no separators.
+
+// Thrown if an ISBN with a bad length, character, or check digit is
+// normalised.
+struct InvalidIsbnException : std::invalid_argument {
+  using invalid_argument::invalid_argument;
+};
+
+// Returns isbn with any hyphens and spaces removed.
+//
+// Example: "978-0-06-443017-3" becomes "9780064430173".
+std::string strip_isbn_separators(const std::string& isbn);
+
+// Returns whether isbn, without separators, is nine digits followed by a
+// correct check digit or 'X'.
+bool is_valid_isbn10(const std::string& isbn);
+
+// Returns whether isbn, without separators, is thirteen digits ending in a
+// correct check digit.
+bool is_valid_isbn13(const std::string& isbn);
+
+// Returns whether isbn is a valid ISBN-10 or ISBN-13.
+bool is_valid_isbn(const std::string& isbn);
+
+// Returns the ISBN-13 for the ISBN-10 isbn.
+//
+// Throws InvalidIsbnException if isbn is not a valid ISBN-10.
+std::string isbn10_to_isbn13(const std::string& isbn);
+
+// Returns isbn in normalised form.
+//
+// Throws InvalidIsbnException if isbn is not a valid ISBN-10 or ISBN-13.
+std::string normalize_isbn(const std::string& isbn);
+
+// Normalises each ISBN in place, replacing invalid ones with an empty string.
+//
+// Returns the number of ISBNs rejected.
+std::size_t normalize_isbns(std::vector<std::string>& isbns);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+// Unit tests for the ISBN functions.
+
+#include <string>
+#include <vector>
+
+#include "doctest.hpp"
+#include "isbn.hpp"
+
+TEST_CASE("IsbnValidation") {
+  SUBCASE("Isbn13") {
+    CHECK(is_valid_isbn13("9780064430173"));
+    CHECK(is_valid_isbn13("978-0-06-443017-3"));
+    CHECK_FALSE(is_valid_isbn13("9780064430174"));
+    CHECK_FALSE(is_valid_isbn13("0064430170"));
+    CHECK_FALSE(is_valid_isbn13("978006443017X"));
+  }
+
+  SUBCASE("Isbn10") {
+    CHECK(is_valid_isbn10("0064430170"));
+    CHECK(is_valid_isbn10("0 06 443017 0"));
+    CHECK(is_valid_isbn10("080442957X"));
+    CHECK(is_valid_isbn10("080442957x"));
+    CHECK_FALSE(is_valid_isbn10("0064430171"));
+    CHECK_FALSE(is_valid_isbn10("X064430170"));
+    CHECK_FALSE(is_valid_isbn10("9780064430173"));
+  }
+
+  SUBCASE("Either") {
+    CHECK(is_valid_isbn("0064430170"));
+    CHECK(is_valid_isbn("9780064430173"));
+    CHECK_FALSE(is_valid_isbn(""));
+    CHECK_FALSE(is_valid_isbn("isbn"));
+    CHECK_FALSE(is_valid_isbn("979010181X"));
+  }
+}
+
+TEST_CASE("IsbnNormalization") {
+  SUBCASE("StripSeparators") {
+    CHECK_EQ("9780064430173", strip_isbn_separators("978-0-06 443017-3"));
+    CHECK_EQ("", strip_isbn_separators("- -"));
+  }
+
+  SUBCASE("Isbn10ToIsbn13") {
+    CHECK_EQ("9780064430173", isbn10_to_isbn13("0-06-443017-0"));
+    CHECK_EQ("9780804429573", isbn10_to_isbn13("080442957X"));
+    CHECK_THROWS_AS(isbn10_to_isbn13("9780064430173"), InvalidIsbnException);
+  }
+
+  SUBCASE("Single") {
+    CHECK_EQ("9780064430173", normalize_isbn("978-0-06-443017-3"));
+    CHECK_EQ("9780064430173", normalize_isbn("0064430170"));
+    CHECK_THROWS_AS(normalize_isbn("0064430171"), InvalidIsbnException);
+  }
+
+  SUBCASE("Batch") {
+    std::vector<std::string> isbns = {
+        "0-06-443017-0", "bogus", "9780804429573", "", "080442957X"};
+    CHECK_EQ(2U, normalize_isbns(isbns));
+    CHECK_EQ(std::vector<std::string>({"9780064430173", "", "9780804429573",
+                                       "", "9780804429573"}),
+             isbns);
+  }
+}
\ No newline at end of file
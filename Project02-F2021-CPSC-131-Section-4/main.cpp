@@ -5,4 +5,16 @@
 #include "doctest.hpp"
 
 #include "book_test.hpp"
-#include "book_list_test.hpp"
\ No newline at end of file
+#include "book_csv_test.hpp"
+#include "book_json_test.hpp"
+#include "book_list_test.hpp"
+#include "book_list_diff_test.hpp"
+#include "book_list_history_test.hpp"
+#include "book_list_log_test.hpp"
+#include "book_list_writer_test.hpp"
+#include "book_stream_test.hpp"
+#include "columnar_book_list_test.hpp"
+#include "compressed_book_list_test.hpp"
+#include "file_io_test.hpp"
+#include "isbn_test.hpp"
+#include "price_kernels_test.hpp"
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "price_kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace {
+
+// The number of independent accumulators in each inner loop.
+constexpr std::size_t lanes = 4;
+
+// The largest block summed directly rather than split in two.
+constexpr std::size_t leaf_size = 256;
+
+// Sums a block of at most leaf_size prices.
+double sum_leaf(std::span<const double> prices) {
+  std::array<double, lanes> sums{};
+  std::size_t i = 0;
+  for (; i + lanes <= prices.size(); i += lanes) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      sums[lane] += prices[i + lane];
+    }
+  }
+  for (; i < prices.size(); ++i) {
+    sums[0] += prices[i];
+  }
+  return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+// Folds prices with pick, which returns the preferred of two prices.
+template <typename Pick>
+double reduce(std::span<const double> prices, Pick pick) {
+  if (prices.empty()) {
+    return 0.0;
+  }
+  std::array<double, lanes> best;
+  best.fill(prices[0]);
+  std::size_t i = 0;
+  for (; i + lanes <= prices.size(); i += lanes) {
+    for (std::size_t lane = 0; lane < lanes; ++lane) {
+      best[lane] = pick(best[lane], prices[i + lane]);
+    }
+  }
+  for (; i < prices.size(); ++i) {
+    best[0] = pick(best[0], prices[i]);
+  }
+  return pick(pick(best[0], best[1]), pick(best[2], best[3]));
+}
+
+}  // namespace
+
+double sum_prices(std::span<const double> prices) {
+  if (prices.size() <= leaf_size) {
+    return sum_leaf(prices);
+  }
+  const std::size_t half = prices.size() / 2;
+  return sum_prices(prices.first(half)) + sum_prices(prices.subspan(half));
+}
+
+double min_price(std::span<const double> prices) {
+  return reduce(prices, [](double lhs, double rhs) {
+    return std::min(lhs, rhs);
+  });
+}
+
+double max_price(std::span<const double> prices) {
+  return reduce(prices, [](double lhs, double rhs) {
+    return std::max(lhs, rhs);
+  });
+}
+
+std::vector<std::size_t> price_histogram(std::span<const double> prices,
+                                         double lo, double hi,
+                                         std::size_t buckets) {
+  if (buckets == 0) {
+    throw InvalidHistogramException("Histogram needs at least one bucket");
+  }
+  if (!(lo < hi)) {
+    throw InvalidHistogramException("Histogram range is empty");
+  }
+
+  const double scale = static_cast<double>(buckets) / (hi - lo);
+  std::vector<std::size_t> counts(buckets, 0);
+  for (double price : prices) {
+    if (price < lo || price > hi) {
+      continue;
+    }
+    // Clamp so rounding and a price of exactly hi land in the last bucket.
+    const std::size_t bucket = std::min(
+        static_cast<std::size_t>((price - lo) * scale), buckets - 1);
+    ++counts[bucket];
+  }
+  return counts;
+}
\ No newline at end of file
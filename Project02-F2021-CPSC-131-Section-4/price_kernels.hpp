@@ -0,0 +1,38 @@
+#ifndef _price_kernels_hpp_
+#define _price_kernels_hpp_
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Aggregation kernels over a contiguous column of prices, such as the one a
+// BookList or ColumnarBookList keeps. Each inner loop runs several
+// independent accumulators so the compiler can keep them in vector lanes.
+
+// Thrown if a histogram is requested with no buckets or an empty range.
+struct InvalidHistogramException : std::invalid_argument {
+  using invalid_argument::invalid_argument;
+};
+
+// Returns the sum of prices, added pairwise so the rounding error grows with
+// the logarithm of the count rather than the count itself.
+double sum_prices(std::span<const double> prices);
+
+// Returns the smallest of prices, or 0.0 if there are none.
+double min_price(std::span<const double> prices);
+
+// Returns the largest of prices, or 0.0 if there are none.
+double max_price(std::span<const double> prices);
+
+// Returns the number of prices falling in each of buckets equal-width
+// buckets spanning lo to hi. A price of exactly hi counts in the last bucket;
+// prices outside the range are not counted.
+//
+// Throws InvalidHistogramException if buckets is zero or lo is not less than
+// hi.
+std::vector<std::size_t> price_histogram(std::span<const double> prices,
+                                         double lo, double hi,
+                                         std::size_t buckets);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+// Unit tests for the price aggregation kernels.
+
+#include <cstddef>
+#include <vector>
+
+#include "doctest.hpp"
+#include "price_kernels.hpp"
+
+TEST_CASE("PriceKernels") {
+  SUBCASE("Empty") {
+    const std::vector<double> prices;
+    CHECK_EQ(0.0, sum_prices(prices));
+    CHECK_EQ(0.0, min_price(prices));
+    CHECK_EQ(0.0, max_price(prices));
+    CHECK_EQ(std::vector<std::size_t>({0U, 0U}),
+             price_histogram(prices, 0.0, 1.0, 2U));
+  }
+
+  SUBCASE("SumMinMax") {
+    // Long enough to split into several leaves, with a remainder that does
+    // not fill every lane.
+    std::vector<double> prices;
+    for (std::size_t i = 0; i < 1003; ++i) {
+      prices.push_back(static_cast<double>(i % 100));
+    }
+    prices[517] = -4.0;
+    prices[998] = 250.0;
+    double expected = 0.0;
+    for (double price : prices) {
+      expected += price;
+    }
+    CHECK_EQ(expected, sum_prices(prices));
+    CHECK_EQ(-4.0, min_price(prices));
+    CHECK_EQ(250.0, max_price(prices));
+  }
+
+  SUBCASE("Accuracy") {
+    // Summing one at a time drifts well away from the exact total.
+    const std::vector<double> prices(1000000, 0.1);
+    CHECK_EQ(doctest::Approx(100000.0).epsilon(1e-12), sum_prices(prices));
+  }
+
+  SUBCASE("Histogram") {
+    const std::vector<double> prices = {0.0, 4.99, 5.0, 9.99, 10.0, -1.0,
+                                        10.01};
+    CHECK_EQ(std::vector<std::size_t>({2U, 3U}),
+             price_histogram(prices, 0.0, 10.0, 2U));
+    CHECK_THROWS_AS(price_histogram(prices, 0.0, 10.0, 0U),
+                    InvalidHistogramException);
+    CHECK_THROWS_AS(price_histogram(prices, 5.0, 5.0, 1U),
+                    InvalidHistogramException);
+  }
+}
\ No newline at end of file